@@ -0,0 +1,214 @@
+#include <ace/core/core.h>
+#include <ace/core/ace_dataobject.h>
+
+#include "benchmarkanalytics.h"
+#include "benchmarkdata.h"
+#include "ccmatrix.h"
+#include "datafactory.h"
+#include "exportcorrelationmatrix_input.h"
+#include "exportexpressionmatrix_input.h"
+#include "importexpressionmatrix_input.h"
+#include "rmt_input.h"
+
+
+
+// run an analytic directly, the way a single process run does, since all of these
+// analytics do their work in one block
+static void run(EAbstractAnalytic* analytic)
+{
+	analytic->initialize();
+	analytic->process(nullptr);
+}
+
+
+
+static void addRows(std::initializer_list<int> geneSizes, std::initializer_list<int> sampleSizes)
+{
+	QTest::addColumn<int>("numGenes");
+	QTest::addColumn<int>("numSamples");
+
+	for ( int numGenes : geneSizes )
+	{
+		for ( int numSamples : sampleSizes )
+		{
+			QString tag {QString("%1 genes/%2 samples").arg(numGenes).arg(numSamples)};
+
+			QTest::newRow(tag.toLatin1().constData()) << numGenes << numSamples;
+		}
+	}
+}
+
+
+
+void BenchmarkAnalytics::importExpressionMatrix_data()
+{
+	addRows({ 1000, 10000 }, { 100, 1000 });
+}
+
+
+
+void BenchmarkAnalytics::importExpressionMatrix()
+{
+	QFETCH(int, numGenes);
+	QFETCH(int, numSamples);
+
+	// write expression data as text with ten percent missing values
+	QString txtPath {BenchmarkData::tempPath("txt")};
+	QString emxPath {BenchmarkData::tempPath("emx")};
+
+	BenchmarkData::writeText(txtPath, BenchmarkData::makeExpressions(numGenes, numSamples, 0.1, 3), numGenes, numSamples);
+
+	QBENCHMARK
+	{
+		QFile input(txtPath);
+		QVERIFY(input.open(QIODevice::ReadOnly));
+
+		QFile(emxPath).remove();
+		std::unique_ptr<Ace::DataObject> emxDataRef {new Ace::DataObject(emxPath, DataFactory::ExpressionMatrixType, EMetadata(EMetadata::Object))};
+
+		ImportExpressionMatrix analytic;
+		EAbstractAnalytic::Input* arguments {analytic.makeInput()};
+		arguments->set(ImportExpressionMatrix::Input::InputFile, &input);
+		arguments->set(ImportExpressionMatrix::Input::OutputData, emxDataRef->data());
+		arguments->set(ImportExpressionMatrix::Input::NoSampleToken, QString("NA"));
+
+		run(&analytic);
+		emxDataRef->data()->finish();
+	}
+}
+
+
+
+void BenchmarkAnalytics::exportExpressionMatrix_data()
+{
+	addRows({ 1000, 10000 }, { 100, 1000 });
+}
+
+
+
+void BenchmarkAnalytics::exportExpressionMatrix()
+{
+	QFETCH(int, numGenes);
+	QFETCH(int, numSamples);
+
+	std::unique_ptr<Ace::DataObject> emxDataRef;
+	ExpressionMatrix* emx {BenchmarkData::makeExpressionMatrix(emxDataRef, BenchmarkData::tempPath("emx"), BenchmarkData::makeExpressions(numGenes, numSamples, 0.1, 3), numGenes, numSamples)};
+
+	QBENCHMARK
+	{
+		QFile output(BenchmarkData::tempPath("txt"));
+		QVERIFY(output.open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+		ExportExpressionMatrix analytic;
+		EAbstractAnalytic::Input* arguments {analytic.makeInput()};
+		arguments->set(ExportExpressionMatrix::Input::InputData, emx);
+		arguments->set(ExportExpressionMatrix::Input::OutputFile, &output);
+		arguments->set(ExportExpressionMatrix::Input::NoSampleToken, QString("NA"));
+
+		run(&analytic);
+	}
+}
+
+
+
+void BenchmarkAnalytics::exportCorrelationMatrix_data()
+{
+	addRows({ 500, 2000 }, { 100 });
+}
+
+
+
+void BenchmarkAnalytics::exportCorrelationMatrix()
+{
+	QFETCH(int, numGenes);
+	QFETCH(int, numSamples);
+
+	// create a correlation matrix of single-cluster pairs, which need no cluster data
+	QVector<float> expressions {BenchmarkData::makeExpressions(numGenes, numSamples, 0.1, 1)};
+	std::unique_ptr<Ace::DataObject> cmxDataRef;
+	CorrelationMatrix* cmx {BenchmarkData::makeCorrelationMatrix(cmxDataRef, BenchmarkData::tempPath("cmx"), expressions, numGenes, numSamples)};
+
+	EMetaArray metaSampleNames;
+	for ( int i = 0; i < numSamples; ++i )
+	{
+		metaSampleNames.append(QString::number(i));
+	}
+
+	QString ccmPath {BenchmarkData::tempPath("ccm")};
+	QFile(ccmPath).remove();
+
+	std::unique_ptr<Ace::DataObject> ccmDataRef {new Ace::DataObject(ccmPath, DataFactory::CCMatrixType, EMetadata(EMetadata::Object))};
+	CCMatrix* ccm {ccmDataRef->data()->cast<CCMatrix>()};
+
+	ccm->initialize(cmx->geneNames(), 1, metaSampleNames);
+	ccm->finish();
+
+	QBENCHMARK
+	{
+		QFile output(BenchmarkData::tempPath("txt"));
+		QVERIFY(output.open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+		ExportCorrelationMatrix analytic;
+		EAbstractAnalytic::Input* arguments {analytic.makeInput()};
+		arguments->set(ExportCorrelationMatrix::Input::ClusterData, ccm);
+		arguments->set(ExportCorrelationMatrix::Input::CorrelationData, cmx);
+		arguments->set(ExportCorrelationMatrix::Input::OutputFile, &output);
+
+		run(&analytic);
+	}
+}
+
+
+
+void BenchmarkAnalytics::rmt_data()
+{
+	QTest::addColumn<int>("numGenes");
+	QTest::addColumn<float>("threshold");
+
+	for ( int numGenes : { 500, 2000 } )
+	{
+		for ( float threshold : { 0.9f, 0.7f, 0.5f } )
+		{
+			QString tag {QString("%1 genes/threshold %2").arg(numGenes).arg(threshold)};
+
+			QTest::newRow(tag.toLatin1().constData()) << numGenes << threshold;
+		}
+	}
+}
+
+
+
+void BenchmarkAnalytics::rmt()
+{
+	QFETCH(int, numGenes);
+	QFETCH(float, threshold);
+
+	QVector<float> expressions {BenchmarkData::makeExpressions(numGenes, 100, 0.1, 1)};
+	std::unique_ptr<Ace::DataObject> cmxDataRef;
+	CorrelationMatrix* cmx {BenchmarkData::makeCorrelationMatrix(cmxDataRef, BenchmarkData::tempPath("cmx"), expressions, numGenes, 100)};
+
+	// evaluate exactly one threshold, including loading the matrix, by making the step
+	// larger than the threshold range so the search stops after the first threshold
+	QBENCHMARK
+	{
+		QFile log(BenchmarkData::tempPath("log"));
+		QVERIFY(log.open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+		RMT analytic;
+		EAbstractAnalytic::Input* arguments {analytic.makeInput()};
+		arguments->set(RMT::Input::InputData, cmx);
+		arguments->set(RMT::Input::LogFile, &log);
+		arguments->set(RMT::Input::ThresholdStart, threshold);
+		arguments->set(RMT::Input::ThresholdStep, 1.0);
+		arguments->set(RMT::Input::ThresholdStop, 0.0);
+
+		try
+		{
+			run(&analytic);
+		}
+		catch ( EException& )
+		{
+			// the search is expected to stop without a final threshold
+		}
+	}
+}
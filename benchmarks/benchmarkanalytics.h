@@ -0,0 +1,23 @@
+#ifndef BENCHMARKANALYTICS_H
+#define BENCHMARKANALYTICS_H
+#include <QtTest/QtTest>
+
+
+
+class BenchmarkAnalytics : public QObject
+{
+	Q_OBJECT
+private slots:
+	void importExpressionMatrix_data();
+	void importExpressionMatrix();
+	void exportExpressionMatrix_data();
+	void exportExpressionMatrix();
+	void exportCorrelationMatrix_data();
+	void exportCorrelationMatrix();
+	void rmt_data();
+	void rmt();
+};
+
+
+
+#endif
@@ -0,0 +1,203 @@
+#include <random>
+
+#include "benchmarkdata.h"
+#include "datafactory.h"
+
+
+
+QVector<float> BenchmarkData::makeExpressions(int numGenes, int numSamples, float missingRate, int numClusters)
+{
+	// use a fixed seed so every run measures the same data
+	std::mt19937 generator(1);
+	std::normal_distribution<float> normal;
+	std::uniform_real_distribution<float> uniform(0, 1);
+
+	// assign samples to clusters in turn and draw one latent value per sample, so that
+	// every pair of genes has a separate linear relationship within each cluster
+	QVector<float> latent(numSamples);
+	for ( int j = 0; j < numSamples; ++j )
+	{
+		latent[j] = normal(generator);
+	}
+
+	QVector<float> expressions(numGenes * numSamples);
+
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		QVector<float> loadings(numClusters);
+		for ( int k = 0; k < numClusters; ++k )
+		{
+			loadings[k] = 2 * uniform(generator) - 1;
+		}
+
+		for ( int j = 0; j < numSamples; ++j )
+		{
+			int k = j % numClusters;
+			float value = 4 * k + loadings[k] * latent[j] + 0.5f * normal(generator);
+
+			expressions[i * numSamples + j] = (uniform(generator) < missingRate) ? NAN : value;
+		}
+	}
+
+	return expressions;
+}
+
+
+
+int BenchmarkData::makePair(const QVector<float>& expressions, int numSamples, int i, int j, QVector<Pairwise::Vector2>& X, QVector<qint8>& labels)
+{
+	// populate X with shared expressions of gene pair, the same as Similarity
+	int n = 0;
+
+	for ( int s = 0; s < numSamples; ++s )
+	{
+		float x = expressions[i * numSamples + s];
+		float y = expressions[j * numSamples + s];
+
+		if ( std::isnan(x) || std::isnan(y) )
+		{
+			labels[s] = -9;
+		}
+		else
+		{
+			X[n] = { x, y };
+			labels[s] = 0;
+			++n;
+		}
+	}
+
+	return n;
+}
+
+
+
+ExpressionMatrix* BenchmarkData::makeExpressionMatrix(std::unique_ptr<Ace::DataObject>& dataRef, const QString& path, const QVector<float>& expressions, int numGenes, int numSamples)
+{
+	QStringList geneNames;
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		geneNames.append(QString::number(i));
+	}
+
+	QStringList sampleNames;
+	for ( int i = 0; i < numSamples; ++i )
+	{
+		sampleNames.append(QString::number(i));
+	}
+
+	QFile(path).remove();
+
+	dataRef.reset(new Ace::DataObject(path, DataFactory::ExpressionMatrixType, EMetadata(EMetadata::Object)));
+	ExpressionMatrix* emx {dataRef->data()->cast<ExpressionMatrix>()};
+
+	emx->initialize(geneNames, sampleNames);
+	emx->writeGenes(0, numGenes, expressions.constData());
+	emx->setTransform(ExpressionMatrix::Transform::None);
+	emx->finish();
+
+	return emx;
+}
+
+
+
+CorrelationMatrix* BenchmarkData::makeCorrelationMatrix(std::unique_ptr<Ace::DataObject>& dataRef, const QString& path, const QVector<float>& expressions, int numGenes, int numSamples)
+{
+	EMetaArray metaGeneNames;
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		metaGeneNames.append(QString::number(i));
+	}
+
+	EMetaArray metaCorrelationNames;
+	metaCorrelationNames.append(QString("pearson"));
+
+	QFile(path).remove();
+
+	dataRef.reset(new Ace::DataObject(path, DataFactory::CorrelationMatrixType, EMetadata(EMetadata::Object)));
+	CorrelationMatrix* cmx {dataRef->data()->cast<CorrelationMatrix>()};
+
+	cmx->initialize(metaGeneNames, 1, metaCorrelationNames);
+
+	// write the correlation of every pair over the samples they share, so the matrix has
+	// the structure of the expression data
+	CorrelationMatrix::Pair pair(cmx);
+
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		for ( int j = 0; j < i; ++j )
+		{
+			double n = 0, sumx = 0, sumy = 0, sumx2 = 0, sumy2 = 0, sumxy = 0;
+
+			for ( int s = 0; s < numSamples; ++s )
+			{
+				float x = expressions[i * numSamples + s];
+				float y = expressions[j * numSamples + s];
+
+				if ( !std::isnan(x) && !std::isnan(y) )
+				{
+					n += 1;
+					sumx += x;
+					sumy += y;
+					sumx2 += x * x;
+					sumy2 += y * y;
+					sumxy += x * y;
+				}
+			}
+
+			pair.clearClusters();
+			pair.addCluster();
+			pair.at(0, 0) = (n*sumxy - sumx*sumy) / sqrt((n*sumx2 - sumx*sumx) * (n*sumy2 - sumy*sumy));
+			pair.write({ i, j });
+		}
+	}
+
+	cmx->finish();
+
+	return cmx;
+}
+
+
+
+void BenchmarkData::writeText(const QString& path, const QVector<float>& expressions, int numGenes, int numSamples)
+{
+	QFile file(path);
+	file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+	QTextStream stream(&file);
+
+	for ( int j = 0; j < numSamples; ++j )
+	{
+		stream << "\t" << j;
+	}
+	stream << "\n";
+
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		stream << i;
+
+		for ( int j = 0; j < numSamples; ++j )
+		{
+			float value = expressions[i * numSamples + j];
+
+			stream << "\t";
+
+			if ( std::isnan(value) )
+			{
+				stream << "NA";
+			}
+			else
+			{
+				stream << value;
+			}
+		}
+
+		stream << "\n";
+	}
+}
+
+
+
+QString BenchmarkData::tempPath(const QString& name)
+{
+	return QDir::tempPath() + "/benchmark." + name;
+}
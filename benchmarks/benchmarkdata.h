@@ -0,0 +1,28 @@
+#ifndef BENCHMARKDATA_H
+#define BENCHMARKDATA_H
+#include <ace/core/core.h>
+#include <ace/core/ace_dataobject.h>
+
+#include "correlationmatrix.h"
+#include "expressionmatrix.h"
+#include "pairwise_linalg.h"
+
+
+
+namespace BenchmarkData
+{
+	// number of gene pairs processed by each iteration of the pairwise benchmarks, so that
+	// pairs per second is this size divided by the time of one iteration
+	constexpr int PAIR_SIZE {256};
+
+	QVector<float> makeExpressions(int numGenes, int numSamples, float missingRate, int numClusters);
+	int makePair(const QVector<float>& expressions, int numSamples, int i, int j, QVector<Pairwise::Vector2>& X, QVector<qint8>& labels);
+	ExpressionMatrix* makeExpressionMatrix(std::unique_ptr<Ace::DataObject>& dataRef, const QString& path, const QVector<float>& expressions, int numGenes, int numSamples);
+	CorrelationMatrix* makeCorrelationMatrix(std::unique_ptr<Ace::DataObject>& dataRef, const QString& path, const QVector<float>& expressions, int numGenes, int numSamples);
+	void writeText(const QString& path, const QVector<float>& expressions, int numGenes, int numSamples);
+	QString tempPath(const QString& name);
+}
+
+
+
+#endif
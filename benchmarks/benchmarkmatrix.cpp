@@ -0,0 +1,225 @@
+#include <random>
+#include <ace/core/core.h>
+#include <ace/core/ace_dataobject.h>
+
+#include "benchmarkmatrix.h"
+#include "benchmarkdata.h"
+#include "ccmatrix.h"
+#include "correlationmatrix.h"
+#include "datafactory.h"
+
+
+
+const int NUM_SAMPLES {100};
+const int MAX_CLUSTERS {5};
+
+
+
+static void addRows()
+{
+	QTest::addColumn<QString>("type");
+	QTest::addColumn<int>("numGenes");
+
+	for ( QString type : { "ccm", "cmx" } )
+	{
+		for ( int numGenes : { 500, 1000 } )
+		{
+			QString tag {QString("%1/%2 genes").arg(type).arg(numGenes)};
+
+			QTest::newRow(tag.toLatin1().constData()) << type << numGenes;
+		}
+	}
+}
+
+
+
+static Pairwise::Matrix* makeMatrix(std::unique_ptr<Ace::DataObject>& dataRef, const QString& type, int numGenes)
+{
+	EMetaArray metaGeneNames;
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		metaGeneNames.append(QString::number(i));
+	}
+
+	QString path {BenchmarkData::tempPath(type)};
+	QFile(path).remove();
+
+	// write every pair with one to three clusters, which is typical of similarity output
+	if ( type == "ccm" )
+	{
+		EMetaArray metaSampleNames;
+		for ( int i = 0; i < NUM_SAMPLES; ++i )
+		{
+			metaSampleNames.append(QString::number(i));
+		}
+
+		dataRef.reset(new Ace::DataObject(path, DataFactory::CCMatrixType, EMetadata(EMetadata::Object)));
+		CCMatrix* ccm {dataRef->data()->cast<CCMatrix>()};
+
+		ccm->initialize(metaGeneNames, MAX_CLUSTERS, metaSampleNames);
+
+		CCMatrix::Pair pair(ccm);
+		Pairwise::Index index;
+
+		for ( qint64 p = 0; p < (qint64)numGenes * (numGenes - 1) / 2; ++p, ++index )
+		{
+			pair.clearClusters();
+			pair.addCluster(1 + p % 3);
+
+			for ( int k = 0; k < pair.clusterSize(); ++k )
+			{
+				for ( int n = 0; n < NUM_SAMPLES; ++n )
+				{
+					pair.at(k, n) = (n % pair.clusterSize() == k);
+				}
+			}
+
+			pair.write(index);
+		}
+
+		ccm->finish();
+		return ccm;
+	}
+	else
+	{
+		EMetaArray metaCorrelationNames;
+		metaCorrelationNames.append(QString("pearson"));
+
+		dataRef.reset(new Ace::DataObject(path, DataFactory::CorrelationMatrixType, EMetadata(EMetadata::Object)));
+		CorrelationMatrix* cmx {dataRef->data()->cast<CorrelationMatrix>()};
+
+		cmx->initialize(metaGeneNames, MAX_CLUSTERS, metaCorrelationNames);
+
+		CorrelationMatrix::Pair pair(cmx);
+		Pairwise::Index index;
+
+		for ( qint64 p = 0; p < (qint64)numGenes * (numGenes - 1) / 2; ++p, ++index )
+		{
+			pair.clearClusters();
+			pair.addCluster(1 + p % 3);
+
+			for ( int k = 0; k < pair.clusterSize(); ++k )
+			{
+				pair.at(k, 0) = (float)(p % 200) / 100 - 1;
+			}
+
+			pair.write(index);
+		}
+
+		cmx->finish();
+		return cmx;
+	}
+}
+
+
+
+struct PairReader
+{
+	// use the pair type of the matrix through its base class
+	PairReader(Pairwise::Matrix* matrix, const QString& type)
+	{
+		if ( type == "ccm" )
+		{
+			ccmPair = CCMatrix::Pair(matrix->cast<CCMatrix>());
+			pair = &ccmPair;
+		}
+		else
+		{
+			cmxPair = CorrelationMatrix::Pair(matrix->cast<CorrelationMatrix>());
+			pair = &cmxPair;
+		}
+	}
+
+	CCMatrix::Pair ccmPair;
+	CorrelationMatrix::Pair cmxPair;
+	Pairwise::Matrix::Pair* pair;
+};
+
+
+
+void BenchmarkMatrix::write_data()
+{
+	addRows();
+}
+
+
+
+void BenchmarkMatrix::write()
+{
+	QFETCH(QString, type);
+	QFETCH(int, numGenes);
+
+	// write every pair of a new matrix
+	QBENCHMARK
+	{
+		std::unique_ptr<Ace::DataObject> dataRef;
+		makeMatrix(dataRef, type, numGenes);
+	}
+}
+
+
+
+void BenchmarkMatrix::readNext_data()
+{
+	addRows();
+}
+
+
+
+void BenchmarkMatrix::readNext()
+{
+	QFETCH(QString, type);
+	QFETCH(int, numGenes);
+
+	std::unique_ptr<Ace::DataObject> dataRef;
+	Pairwise::Matrix* matrix {makeMatrix(dataRef, type, numGenes)};
+	PairReader reader(matrix, type);
+
+	// read every pair in order
+	QBENCHMARK
+	{
+		reader.pair->reset();
+
+		while ( reader.pair->hasNext() )
+		{
+			reader.pair->readNext();
+		}
+	}
+}
+
+
+
+void BenchmarkMatrix::read_data()
+{
+	addRows();
+}
+
+
+
+void BenchmarkMatrix::read()
+{
+	QFETCH(QString, type);
+	QFETCH(int, numGenes);
+
+	std::unique_ptr<Ace::DataObject> dataRef;
+	Pairwise::Matrix* matrix {makeMatrix(dataRef, type, numGenes)};
+	PairReader reader(matrix, type);
+
+	// look up random pairs, which finds each one with a binary search
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<qint64> distribution(0, (qint64)numGenes * (numGenes - 1) / 2 - 1);
+	QVector<Pairwise::Index> indices;
+
+	for ( int i = 0; i < BenchmarkData::PAIR_SIZE; ++i )
+	{
+		indices.append(Pairwise::Index(distribution(generator)));
+	}
+
+	QBENCHMARK
+	{
+		for ( auto& index : indices )
+		{
+			reader.pair->read(index);
+		}
+	}
+}
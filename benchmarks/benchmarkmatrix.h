@@ -0,0 +1,21 @@
+#ifndef BENCHMARKMATRIX_H
+#define BENCHMARKMATRIX_H
+#include <QtTest/QtTest>
+
+
+
+class BenchmarkMatrix : public QObject
+{
+	Q_OBJECT
+private slots:
+	void write_data();
+	void write();
+	void readNext_data();
+	void readNext();
+	void read_data();
+	void read();
+};
+
+
+
+#endif
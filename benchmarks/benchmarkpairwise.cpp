@@ -0,0 +1,158 @@
+#include <ace/core/core.h>
+
+#include "benchmarkpairwise.h"
+#include "benchmarkdata.h"
+#include "pairwise_gmm.h"
+#include "pairwise_kmeans.h"
+#include "pairwise_pearson.h"
+#include "pairwise_spearman.h"
+
+
+
+// number of genes to draw pairs from, which gives more than PAIR_SIZE pairs
+const int NUM_GENES {32};
+
+
+
+struct PairData
+{
+	QVector<QVector<Pairwise::Vector2>> X;
+	QVector<QVector<qint8>> labels;
+	QVector<int> numSamples;
+};
+
+
+
+static PairData makePairs(const QVector<float>& expressions, int numSamples)
+{
+	// build the input of the first PAIR_SIZE pairs so that only the kernels are timed
+	PairData data;
+	Pairwise::Index index;
+
+	for ( int p = 0; p < BenchmarkData::PAIR_SIZE; ++p, ++index )
+	{
+		QVector<Pairwise::Vector2> X(numSamples);
+		QVector<qint8> labels(numSamples);
+
+		data.numSamples.append(BenchmarkData::makePair(expressions, numSamples, index.getX(), index.getY(), X, labels));
+		data.X.append(X);
+		data.labels.append(labels);
+	}
+
+	return data;
+}
+
+
+
+void BenchmarkPairwise::clustering_data()
+{
+	QTest::addColumn<QString>("method");
+	QTest::addColumn<int>("numSamples");
+	QTest::addColumn<float>("missingRate");
+	QTest::addColumn<int>("numClusters");
+
+	for ( QString method : { "gmm", "kmeans" } )
+	{
+		for ( int numSamples : { 100, 1000 } )
+		{
+			for ( float missingRate : { 0.0f, 0.1f } )
+			{
+				for ( int numClusters : { 1, 3 } )
+				{
+					QString tag {QString("%1/%2 samples/%3 missing/%4 clusters")
+						.arg(method).arg(numSamples).arg(missingRate).arg(numClusters)};
+
+					QTest::newRow(tag.toLatin1().constData()) << method << numSamples << missingRate << numClusters;
+				}
+			}
+		}
+	}
+}
+
+
+
+void BenchmarkPairwise::clustering()
+{
+	QFETCH(QString, method);
+	QFETCH(int, numSamples);
+	QFETCH(float, missingRate);
+	QFETCH(int, numClusters);
+
+	// create expression data and the input of each pair
+	QVector<float> expressions {BenchmarkData::makeExpressions(NUM_GENES, numSamples, missingRate, numClusters)};
+	std::unique_ptr<Ace::DataObject> emxDataRef;
+	ExpressionMatrix* emx {BenchmarkData::makeExpressionMatrix(emxDataRef, BenchmarkData::tempPath("emx"), expressions, NUM_GENES, numSamples)};
+	PairData data {makePairs(expressions, numSamples)};
+
+	// create clustering model
+	Pairwise::GMM gmm;
+	Pairwise::KMeans kmeans;
+	Pairwise::Clustering* model {(method == "gmm") ? (Pairwise::Clustering*)&gmm : &kmeans};
+
+	model->initialize(emx);
+
+	// fit every pair with the default similarity settings
+	QBENCHMARK
+	{
+		for ( int p = 0; p < BenchmarkData::PAIR_SIZE; ++p )
+		{
+			QVector<qint8> labels {data.labels[p]};
+
+			model->compute(data.X[p], data.numSamples[p], labels, 30, 1, 5, Pairwise::Criterion::ICL, false, false);
+		}
+	}
+}
+
+
+
+void BenchmarkPairwise::correlation_data()
+{
+	QTest::addColumn<QString>("method");
+	QTest::addColumn<int>("numSamples");
+	QTest::addColumn<float>("missingRate");
+
+	for ( QString method : { "pearson", "spearman" } )
+	{
+		for ( int numSamples : { 100, 1000, 10000 } )
+		{
+			for ( float missingRate : { 0.0f, 0.1f } )
+			{
+				QString tag {QString("%1/%2 samples/%3 missing")
+					.arg(method).arg(numSamples).arg(missingRate)};
+
+				QTest::newRow(tag.toLatin1().constData()) << method << numSamples << missingRate;
+			}
+		}
+	}
+}
+
+
+
+void BenchmarkPairwise::correlation()
+{
+	QFETCH(QString, method);
+	QFETCH(int, numSamples);
+	QFETCH(float, missingRate);
+
+	// create expression data and the input of each pair
+	QVector<float> expressions {BenchmarkData::makeExpressions(NUM_GENES, numSamples, missingRate, 1)};
+	std::unique_ptr<Ace::DataObject> emxDataRef;
+	ExpressionMatrix* emx {BenchmarkData::makeExpressionMatrix(emxDataRef, BenchmarkData::tempPath("emx"), expressions, NUM_GENES, numSamples)};
+	PairData data {makePairs(expressions, numSamples)};
+
+	// create correlation model
+	Pairwise::Pearson pearson;
+	Pairwise::Spearman spearman;
+	Pairwise::Correlation* model {(method == "pearson") ? (Pairwise::Correlation*)&pearson : &spearman};
+
+	model->initialize(emx);
+
+	// compute the correlation of every pair as a single cluster
+	QBENCHMARK
+	{
+		for ( int p = 0; p < BenchmarkData::PAIR_SIZE; ++p )
+		{
+			model->compute(data.X[p], 1, data.labels[p], 30);
+		}
+	}
+}
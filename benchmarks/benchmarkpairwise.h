@@ -0,0 +1,19 @@
+#ifndef BENCHMARKPAIRWISE_H
+#define BENCHMARKPAIRWISE_H
+#include <QtTest/QtTest>
+
+
+
+class BenchmarkPairwise : public QObject
+{
+	Q_OBJECT
+private slots:
+	void clustering_data();
+	void clustering();
+	void correlation_data();
+	void correlation();
+};
+
+
+
+#endif
@@ -0,0 +1,72 @@
+#include <ace/core/core.h>
+
+#include "benchmarksimilarity.h"
+#include "benchmarkdata.h"
+#include "similarity_input.h"
+#include "similarity_serial.h"
+#include "similarity_workblock.h"
+
+
+
+void BenchmarkSimilarity::execute_data()
+{
+	QTest::addColumn<QString>("clusteringMethod");
+	QTest::addColumn<QString>("correlationMethod");
+	QTest::addColumn<int>("numGenes");
+	QTest::addColumn<int>("numSamples");
+	QTest::addColumn<float>("missingRate");
+
+	// clustering "none" with pearson is dominated by fetching the expressions of each pair
+	for ( QString clusteringMethod : { "none", "gmm", "kmeans" } )
+	{
+		for ( QString correlationMethod : { "pearson", "spearman" } )
+		{
+			for ( int numSamples : { 100, 1000 } )
+			{
+				for ( float missingRate : { 0.0f, 0.1f } )
+				{
+					int numGenes {1000};
+					QString tag {QString("%1/%2/%3 genes/%4 samples/%5 missing")
+						.arg(clusteringMethod).arg(correlationMethod).arg(numGenes).arg(numSamples).arg(missingRate)};
+
+					QTest::newRow(tag.toLatin1().constData()) << clusteringMethod << correlationMethod << numGenes << numSamples << missingRate;
+				}
+			}
+		}
+	}
+}
+
+
+
+void BenchmarkSimilarity::execute()
+{
+	QFETCH(QString, clusteringMethod);
+	QFETCH(QString, correlationMethod);
+	QFETCH(int, numGenes);
+	QFETCH(int, numSamples);
+	QFETCH(float, missingRate);
+
+	// create expression matrix with three clusters per pair
+	QVector<float> expressions {BenchmarkData::makeExpressions(numGenes, numSamples, missingRate, 3)};
+	std::unique_ptr<Ace::DataObject> emxDataRef;
+	ExpressionMatrix* emx {BenchmarkData::makeExpressionMatrix(emxDataRef, BenchmarkData::tempPath("emx"), expressions, numGenes, numSamples)};
+
+	// configure similarity analytic with the serial implementation, whose input and
+	// serial objects are owned by the analytic
+	Similarity analytic;
+	EAbstractAnalytic::Input* input {analytic.makeInput()};
+	input->set(Similarity::Input::InputData, emx);
+	input->set(Similarity::Input::ClusteringType, clusteringMethod);
+	input->set(Similarity::Input::CorrelationType, correlationMethod);
+
+	EAbstractAnalytic::Serial* serial {analytic.makeSerial()};
+
+	// execute a work block of the last pairs of the matrix, whose genes are far apart
+	qint64 numPairs {(qint64)numGenes * (numGenes - 1) / 2};
+	Similarity::WorkBlock block(0, numPairs - BenchmarkData::PAIR_SIZE, BenchmarkData::PAIR_SIZE);
+
+	QBENCHMARK
+	{
+		serial->execute(&block);
+	}
+}
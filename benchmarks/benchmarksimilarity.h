@@ -0,0 +1,17 @@
+#ifndef BENCHMARKSIMILARITY_H
+#define BENCHMARKSIMILARITY_H
+#include <QtTest/QtTest>
+
+
+
+class BenchmarkSimilarity : public QObject
+{
+	Q_OBJECT
+private slots:
+	void execute_data();
+	void execute();
+};
+
+
+
+#endif
@@ -0,0 +1,44 @@
+#include "analyticfactory.h"
+#include "datafactory.h"
+#include "benchmarkanalytics.h"
+#include "benchmarkmatrix.h"
+#include "benchmarkpairwise.h"
+#include "benchmarksimilarity.h"
+
+
+
+int main(int argc, char **argv)
+{
+	std::unique_ptr<EAbstractAnalyticFactory> analyticFactory(new AnalyticFactory);
+	std::unique_ptr<EAbstractDataFactory> dataFactory(new DataFactory);
+	EAbstractAnalyticFactory::setInstance(move(analyticFactory));
+	EAbstractDataFactory::setInstance(move(dataFactory));
+
+	int status {0};
+	auto RUN_BENCHMARK = [&status, argc, argv](QObject* object)
+	{
+		status |= QTest::qExec(object, argc, argv);
+		delete object;
+	};
+
+	try
+	{
+		RUN_BENCHMARK(new BenchmarkPairwise);
+		RUN_BENCHMARK(new BenchmarkSimilarity);
+		RUN_BENCHMARK(new BenchmarkMatrix);
+		RUN_BENCHMARK(new BenchmarkAnalytics);
+	}
+	catch ( EException& e )
+	{
+		QTextStream stream(stdout);
+		stream << QObject::tr("CRITICAL ERROR\n\n");
+		stream << e.title() << QObject::tr("\n\n");
+		stream << e.details() << QObject::tr("\n\n");
+		stream << QObject::tr("File: %1\nLine: %2\nFunction: %3\n")
+			.arg(e.fileName())
+			.arg(e.line())
+			.arg(e.functionName());
+	}
+
+	return status;
+}
@@ -16,7 +16,7 @@ DEFINES += \
     REVISION=$${REVISION}
 
 # Basic settings
-QT += core
+QT += core concurrent
 TEMPLATE = app
 QMAKE_CXX = mpic++
 CONFIG += c++11
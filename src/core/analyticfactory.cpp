@@ -1,11 +1,15 @@
 #include "analyticfactory.h"
 #include "importexpressionmatrix.h"
+#include "importbinaryexpressionmatrix.h"
+#include "transformexpressionmatrix.h"
+#include "indexcorrelationmatrix.h"
 #include "exportexpressionmatrix.h"
 #include "importcorrelationmatrix.h"
 #include "exportcorrelationmatrix.h"
 #include "similarity.h"
 #include "rmt.h"
 #include "extract.h"
+#include "mergesimilarity.h"
 
 
 
@@ -37,6 +41,10 @@ QString AnalyticFactory::name(quint16 type) const
    case SimilarityType: return "Similarity";
    case RMTType: return "RMT Thresholding";
    case ExtractType: return "Extract Network";
+   case MergeSimilarityType: return "Merge Similarity Shards";
+   case ImportBinaryExpressionMatrixType: return "Import Binary Expression Matrix";
+   case TransformExpressionMatrixType: return "Transform Expression Matrix";
+   case IndexCorrelationMatrixType: return "Index Correlation Matrix";
    default: return QString();
    }
 }
@@ -57,6 +65,10 @@ QString AnalyticFactory::commandName(quint16 type) const
    case SimilarityType: return "similarity";
    case RMTType: return "rmt";
    case ExtractType: return "extract";
+   case MergeSimilarityType: return "merge-similarity";
+   case ImportBinaryExpressionMatrixType: return "import-emx-binary";
+   case TransformExpressionMatrixType: return "transform-emx";
+   case IndexCorrelationMatrixType: return "index-cmx";
    default: return QString();
    }
 }
@@ -77,6 +89,10 @@ std::unique_ptr<EAbstractAnalytic> AnalyticFactory::make(quint16 type) const
    case SimilarityType: return unique_ptr<EAbstractAnalytic>(new Similarity);
    case RMTType: return unique_ptr<EAbstractAnalytic>(new RMT);
    case ExtractType: return unique_ptr<EAbstractAnalytic>(new Extract);
+   case MergeSimilarityType: return unique_ptr<EAbstractAnalytic>(new MergeSimilarity);
+   case ImportBinaryExpressionMatrixType: return unique_ptr<EAbstractAnalytic>(new ImportBinaryExpressionMatrix);
+   case TransformExpressionMatrixType: return unique_ptr<EAbstractAnalytic>(new TransformExpressionMatrix);
+   case IndexCorrelationMatrixType: return unique_ptr<EAbstractAnalytic>(new IndexCorrelationMatrix);
    default: return nullptr;
    }
 }
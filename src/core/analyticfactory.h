@@ -16,6 +16,10 @@ public:
       ,SimilarityType
       ,RMTType
       ,ExtractType
+      ,MergeSimilarityType
+      ,ImportBinaryExpressionMatrixType
+      ,TransformExpressionMatrixType
+      ,IndexCorrelationMatrixType
       ,Total
    };
    virtual quint16 size() const override final;
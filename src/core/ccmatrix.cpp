@@ -86,7 +86,8 @@ QVariant CCMatrix::data(const QModelIndex &index, int role) const
       return "";
    }
 
-   // get constant pair and read in values
+   // get constant pair and read in values from the cached row of the pair, so that
+   // neighboring cells do not each search the data object
    const Pair pair(this);
    int x {index.row()};
    int y {index.column()};
@@ -94,7 +95,7 @@ QVariant CCMatrix::data(const QModelIndex &index, int role) const
    {
       swap(x,y);
    }
-   pair.read({x,y});
+   pair.read(cachedRow(x), y);
 
    // Return value of pair as a string
    return pair.toString();
@@ -220,12 +221,12 @@ QString CCMatrix::Pair::toString() const
 
 
 
-void CCMatrix::Pair::writeCluster(EDataStream &stream, int cluster)
+void CCMatrix::Pair::writeCluster(char* data, int cluster)
 {
    // make sure cluster value is within range
    if ( cluster >= 0 && cluster < _sampleMasks.size() )
    {
-      // write each sample to output stream
+      // pack each pair of samples into one byte of the item data
       auto& samples {_sampleMasks.at(cluster)};
 
       for ( int i = 0; i < samples.size(); i += 2 )
@@ -237,7 +238,7 @@ void CCMatrix::Pair::writeCluster(EDataStream &stream, int cluster)
             value |= (samples[i + 1] << 4);
          }
 
-         stream << value;
+         data[i / 2] = value;
       }
    }
 }
@@ -247,18 +248,17 @@ void CCMatrix::Pair::writeCluster(EDataStream &stream, int cluster)
 
 
 
-void CCMatrix::Pair::readCluster(const EDataStream &stream, int cluster) const
+void CCMatrix::Pair::readCluster(const char* data, int cluster) const
 {
    // make sure cluster value is within range
    if ( cluster >= 0 && cluster < _sampleMasks.size() )
    {
-      // read each sample from input stream
+      // unpack each pair of samples from one byte of the item data
       auto& samples {_sampleMasks[cluster]};
 
       for ( int i = 0; i < samples.size(); i += 2 )
       {
-         qint8 value;
-         stream >> value;
+         qint8 value {(qint8)data[i / 2]};
 
          samples[i] = value & 0x0F;
 
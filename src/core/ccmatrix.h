@@ -46,8 +46,8 @@ public:
    const qint8& at(int cluster, int sample) const { return _sampleMasks.at(cluster).at(sample); }
    qint8& at(int cluster, int sample) { return _sampleMasks[cluster][sample]; }
 private:
-   virtual void writeCluster(EDataStream& stream, int cluster);
-   virtual void readCluster(const EDataStream& stream, int cluster) const;
+   virtual void writeCluster(char* data, int cluster);
+   virtual void readCluster(const char* data, int cluster) const;
    mutable QVector<QVector<qint8>> _sampleMasks;
    const CCMatrix* _cMatrix;
 };
@@ -7,7 +7,7 @@ CONFIG += staticlib
 DESTDIR = $$PWD/../../build/libs/
 
 # Qt libraries
-QT += core
+QT += core concurrent
 
 # Preprocessor defines
 DEFINES += QT_DEPRECATED_WARNINGS
@@ -19,6 +19,7 @@ QMAKE_CXXFLAGS += -Wno-ignored-attributes
 SOURCES += \
    analyticfactory.cpp \
    ccmatrix.cpp \
+   correlationmatrix_thresholdindex.cpp \
    correlationmatrix.cpp \
    datafactory.cpp \
    exportcorrelationmatrix_input.cpp \
@@ -28,10 +29,16 @@ SOURCES += \
    expressionmatrix.cpp \
    extract_input.cpp \
    extract.cpp \
+   importbinaryexpressionmatrix_input.cpp \
+   importbinaryexpressionmatrix.cpp \
    importcorrelationmatrix_input.cpp \
    importcorrelationmatrix.cpp \
    importexpressionmatrix_input.cpp \
    importexpressionmatrix.cpp \
+   indexcorrelationmatrix_input.cpp \
+   indexcorrelationmatrix.cpp \
+   mergesimilarity_input.cpp \
+   mergesimilarity.cpp \
    pairwise_clustering.cpp \
    pairwise_correlation.cpp \
    pairwise_gmm.cpp \
@@ -39,10 +46,12 @@ SOURCES += \
    pairwise_kmeans.cpp \
    pairwise_linalg.cpp \
    pairwise_matrix.cpp \
+   pairwise_matrixwindow.cpp \
    pairwise_pearson.cpp \
    pairwise_spearman.cpp \
    rmt_input.cpp \
    rmt.cpp \
+   similarity_checkpoint.cpp \
    similarity_input.cpp \
    similarity_opencl_fetchpair.cpp \
    similarity_opencl_gmm.cpp \
@@ -51,15 +60,21 @@ SOURCES += \
    similarity_opencl_spearman.cpp \
    similarity_opencl_worker.cpp \
    similarity_opencl.cpp \
+   similarity_pairset.cpp \
    similarity_resultblock.cpp \
    similarity_serial.cpp \
+   similarity_statistics.cpp \
    similarity_workblock.cpp \
-   similarity.cpp
+   similarity.cpp \
+   textio.cpp \
+   transformexpressionmatrix_input.cpp \
+   transformexpressionmatrix.cpp
 
 # Header files
 HEADERS += \
    analyticfactory.h \
    ccmatrix.h \
+   correlationmatrix_thresholdindex.h \
    correlationmatrix.h \
    datafactory.h \
    exportcorrelationmatrix_input.h \
@@ -69,10 +84,16 @@ HEADERS += \
    expressionmatrix.h \
    extract_input.h \
    extract.h \
+   importbinaryexpressionmatrix_input.h \
+   importbinaryexpressionmatrix.h \
    importcorrelationmatrix_input.h \
    importcorrelationmatrix.h \
    importexpressionmatrix_input.h \
    importexpressionmatrix.h \
+   indexcorrelationmatrix_input.h \
+   indexcorrelationmatrix.h \
+   mergesimilarity_input.h \
+   mergesimilarity.h \
    pairwise_clustering.h \
    pairwise_correlation.h \
    pairwise_gmm.h \
@@ -80,10 +101,12 @@ HEADERS += \
    pairwise_kmeans.h \
    pairwise_linalg.h \
    pairwise_matrix.h \
+   pairwise_matrixwindow.h \
    pairwise_pearson.h \
    pairwise_spearman.h \
    rmt_input.h \
    rmt.h \
+   similarity_checkpoint.h \
    similarity_input.h \
    similarity_opencl_fetchpair.h \
    similarity_opencl_gmm.h \
@@ -92,7 +115,12 @@ HEADERS += \
    similarity_opencl_spearman.h \
    similarity_opencl_worker.h \
    similarity_opencl.h \
+   similarity_pairset.h \
    similarity_resultblock.h \
    similarity_serial.h \
+   similarity_statistics.h \
    similarity_workblock.h \
-   similarity.h
+   similarity.h \
+   textio.h \
+   transformexpressionmatrix_input.h \
+   transformexpressionmatrix.h
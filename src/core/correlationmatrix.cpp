@@ -66,7 +66,8 @@ QVariant CorrelationMatrix::data(const QModelIndex& index, int role) const
       return "1";
    }
 
-   // get constant pair and read in values
+   // get constant pair and read in values from the cached row of the pair, so that
+   // neighboring cells do not each search the data object
    const Pair pair(this);
    int x {index.row()};
    int y {index.column()};
@@ -74,7 +75,7 @@ QVariant CorrelationMatrix::data(const QModelIndex& index, int role) const
    {
       swap(x,y);
    }
-   pair.read({x,y});
+   pair.read(cachedRow(x), y);
 
    // Return value of pair as a string
    return pair.toString();
@@ -228,16 +229,18 @@ QString CorrelationMatrix::Pair::toString() const
 
 
 
-void CorrelationMatrix::Pair::writeCluster(EDataStream& stream, int cluster)
+void CorrelationMatrix::Pair::writeCluster(char* data, int cluster)
 {
    // make sure cluster value is within range
    if ( cluster >= 0 && cluster < _correlations.size() )
    {
-      // write correlations per cluster to output stream
-      for (const auto& correlation : _correlations.at(cluster))
-      {
-         stream << correlation;
-      }
+      // copy correlations of cluster into the item data and zero the rest of the item,
+      // which would otherwise keep the bytes of an earlier item in the write buffer
+      const auto& correlations {_correlations.at(cluster)};
+      const int size {qMin(correlations.size(), (int)_cMatrix->_correlationSize)};
+
+      memcpy(data, correlations.constData(), size * sizeof(float));
+      memset(data + size * sizeof(float), 0, (_cMatrix->_correlationSize - size) * sizeof(float));
    }
 }
 
@@ -246,17 +249,12 @@ void CorrelationMatrix::Pair::writeCluster(EDataStream& stream, int cluster)
 
 
 
-void CorrelationMatrix::Pair::readCluster(const EDataStream& stream, int cluster) const
+void CorrelationMatrix::Pair::readCluster(const char* data, int cluster) const
 {
    // make sure cluster value is within range
    if ( cluster >= 0 && cluster < _correlations.size() )
    {
-      // read correlations per cluster from input stream
-      for (int i = 0; i < _cMatrix->_correlationSize ;++i)
-      {
-         float value;
-         stream >> value;
-         _correlations[cluster][i] = value;
-      }
+      // copy correlations of cluster from the item data
+      memcpy(_correlations[cluster].data(), data, _cMatrix->_correlationSize * sizeof(float));
    }
 }
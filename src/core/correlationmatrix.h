@@ -9,6 +9,7 @@ class CorrelationMatrix : public Pairwise::Matrix
    Q_OBJECT
 public:
    class Pair;
+   class ThresholdIndex;
    virtual QAbstractTableModel* model() override final;
    QVariant headerData(int section, Qt::Orientation orientation, int role) const;
    int rowCount(const QModelIndex&) const;
@@ -47,8 +48,8 @@ public:
       { return _correlations.at(cluster).at(correlation); }
    float& at(int cluster, int correlation) { return _correlations[cluster][correlation]; }
 private:
-   virtual void writeCluster(EDataStream& stream, int cluster);
-   virtual void readCluster(const EDataStream& stream, int cluster) const;
+   virtual void writeCluster(char* data, int cluster);
+   virtual void readCluster(const char* data, int cluster) const;
    mutable QVector<QVector<float>> _correlations;
    const CorrelationMatrix* _cMatrix;
 };
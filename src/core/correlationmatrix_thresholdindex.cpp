@@ -0,0 +1,154 @@
+#include "correlationmatrix_thresholdindex.h"
+#include "pairwise_matrixwindow.h"
+
+
+
+
+
+
+void CorrelationMatrix::ThresholdIndex::build(qint64 blockSize)
+{
+   _blocks.clear();
+
+   // read correlation matrix in blocks of whole pairs and save the range of absolute
+   // correlations of each block, ignoring correlations that are NAN
+   Pairwise::MatrixWindow window(_matrix, nullptr, blockSize);
+   qint64 begin {0};
+
+   while ( window.next() )
+   {
+      Block block {begin, window.size(), std::numeric_limits<float>::infinity(), 0};
+
+      for ( qint64 i = 0; i < window.size(); ++i )
+      {
+         float correlation;
+         memcpy(&correlation, window.data(i), sizeof(float));
+         correlation = fabs(correlation);
+
+         if ( !std::isnan(correlation) )
+         {
+            block.min = qMin(block.min, correlation);
+            block.max = qMax(block.max, correlation);
+         }
+      }
+
+      _blocks.append(block);
+      begin += window.size();
+   }
+}
+
+
+
+
+
+
+void CorrelationMatrix::ThresholdIndex::save(QFile* file) const
+{
+   QDataStream stream(file);
+   stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+   // write header which identifies the correlation matrix the index was built from
+   stream << MAGIC << VERSION << (qint32)_matrix->geneSize() << _matrix->clusterSize()
+          << (qint32)_blocks.size();
+
+   // write blocks
+   for ( auto& block : _blocks )
+   {
+      stream << block.begin << block.size << block.min << block.max;
+   }
+
+   // make sure writing index file worked
+   if ( stream.status() != QDataStream::Ok )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(QObject::tr("File IO Error"));
+      e.setDetails(QObject::tr("Failed writing threshold index file: %1").arg(file->errorString()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+void CorrelationMatrix::ThresholdIndex::load(QFile* file)
+{
+   QDataStream stream(file);
+   stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+   // read header and make sure it is an index of this correlation matrix
+   quint32 magic;
+   qint32 version;
+   qint32 geneSize;
+   qint64 clusterSize;
+   qint32 blockSize;
+   stream >> magic >> version >> geneSize >> clusterSize >> blockSize;
+
+   if ( stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(QObject::tr("File IO Error"));
+      e.setDetails(QObject::tr("File is not a threshold index of a correlation matrix."));
+      throw e;
+   }
+
+   if ( geneSize != _matrix->geneSize() || clusterSize != _matrix->clusterSize() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(QObject::tr("Invalid Argument"));
+      e.setDetails(QObject::tr("Threshold index was built from a different correlation matrix "
+                               "with %1 genes and %2 clusters.").arg(geneSize).arg(clusterSize));
+      throw e;
+   }
+
+   // read blocks
+   _blocks.resize(blockSize);
+
+   for ( auto& block : _blocks )
+   {
+      stream >> block.begin >> block.size >> block.min >> block.max;
+   }
+
+   if ( stream.status() != QDataStream::Ok )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(QObject::tr("File IO Error"));
+      e.setDetails(QObject::tr("Threshold index file is truncated."));
+      throw e;
+   }
+}
+
+
+
+
+
+
+QVector<CorrelationMatrix::ThresholdIndex::Block> CorrelationMatrix::ThresholdIndex::select(float minCorrelation, float maxCorrelation) const
+{
+   // return the ranges of blocks that may contain an absolute correlation within the
+   // given band, merging adjacent blocks into one range
+   QVector<Block> ranges;
+
+   for ( auto& block : _blocks )
+   {
+      if ( block.max < minCorrelation || maxCorrelation < block.min )
+      {
+         continue;
+      }
+
+      if ( !ranges.isEmpty() && ranges.last().begin + ranges.last().size == block.begin )
+      {
+         Block& range {ranges.last()};
+         range.size += block.size;
+         range.min = qMin(range.min, block.min);
+         range.max = qMax(range.max, block.max);
+      }
+      else
+      {
+         ranges.append(block);
+      }
+   }
+
+   return ranges;
+}
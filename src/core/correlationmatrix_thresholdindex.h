@@ -0,0 +1,37 @@
+#ifndef CORRELATIONMATRIX_THRESHOLDINDEX_H
+#define CORRELATIONMATRIX_THRESHOLDINDEX_H
+#include "correlationmatrix.h"
+
+
+
+// summary of the smallest and largest absolute correlation in each block of whole pairs
+// of a correlation matrix, which is saved to a separate file so that analytics which only
+// need correlations within a band can skip the blocks that cannot contain any
+class CorrelationMatrix::ThresholdIndex
+{
+public:
+   struct Block
+   {
+      qint64 begin;
+      qint64 size;
+      float min;
+      float max;
+   };
+   ThresholdIndex(const CorrelationMatrix* matrix):
+      _matrix(matrix)
+      {}
+   void build(qint64 blockSize);
+   void save(QFile* file) const;
+   void load(QFile* file);
+   QVector<Block> select(float minCorrelation, float maxCorrelation) const;
+   const QVector<Block>& blocks() const { return _blocks; }
+private:
+   constexpr static quint32 MAGIC {0x4B544958};
+   constexpr static qint32 VERSION {1};
+   const CorrelationMatrix* _matrix;
+   QVector<Block> _blocks;
+};
+
+
+
+#endif
@@ -1,6 +1,10 @@
 #include "exportcorrelationmatrix.h"
 #include "exportcorrelationmatrix_input.h"
 #include "datafactory.h"
+#include "pairwise_matrixwindow.h"
+#include "textio.h"
+
+#include <QtConcurrent>
 
 
 
@@ -18,102 +22,55 @@ void ExportCorrelationMatrix::process(const EAbstractAnalytic::Block* result)
 {
    Q_UNUSED(result);
 
-   // initialize pair iterators
-   CorrelationMatrix::Pair cmxPair(_cmx);
-   CCMatrix::Pair ccmPair(_ccm);
-
-   // initialize workspace
-   QString sampleMask(_ccm->sampleSize(), '0');
-
-   // create text stream to output file and write until end reached
-   QTextStream stream(_output);
-   stream.setRealNumberPrecision(6);
+   // read the correlation matrix in windows of raw items, along with the cluster matrix
+   // items of the same pairs, and format each window in parallel chunks which are written
+   // in order
+   const int CHUNK_SIZE {4096};
+   Pairwise::MatrixWindow window(_cmx, _ccm, 16 * CHUNK_SIZE);
 
-   // iterate through all pairs
-   while ( cmxPair.hasNext() )
+   while ( window.next() )
    {
-      // read next pair
-      cmxPair.readNext();
+      const qint64 size {window.size()};
 
-      if ( cmxPair.clusterSize() > 1 )
+      // format chunks of the window in parallel, saving the error of any chunk so it can
+      // be thrown from this thread
+      QVector<int> chunks;
+      for ( int i = 0; i < size; i += CHUNK_SIZE )
       {
-         ccmPair.read(cmxPair.index());
+         chunks.append(i);
       }
+      QVector<QByteArray> texts(chunks.size());
+      QVector<std::exception_ptr> errors(chunks.size());
 
-      // write pairwise data to output file
-      for ( int k = 0; k < cmxPair.clusterSize(); k++ )
+      QtConcurrent::blockingMap(chunks, [&](int& begin)
       {
-         float correlation = cmxPair.at(k, 0);
-         int numSamples = 0;
-         int numMissing = 0;
-         int numPostOutliers = 0;
-         int numPreOutliers = 0;
-         int numThreshold = 0;
-
-         // if there are multiple clusters then use cluster data
-         if ( cmxPair.clusterSize() > 1 )
+         try
+         {
+            formatClusters(window, begin, qMin((qint64)CHUNK_SIZE, size - begin), &texts[begin / CHUNK_SIZE]);
+         }
+         catch ( ... )
          {
-            // compute summary statistics
-            for ( int i = 0; i < _ccm->sampleSize(); i++ )
-            {
-               switch ( ccmPair.at(k, i) )
-               {
-               case 1:
-                  numSamples++;
-                  break;
-               case 6:
-                  numThreshold++;
-                  break;
-               case 7:
-                  numPreOutliers++;
-                  break;
-               case 8:
-                  numPostOutliers++;
-                  break;
-               case 9:
-                  numMissing++;
-                  break;
-               }
-            }
-
-            // write sample mask to string
-            for ( int i = 0; i < _ccm->sampleSize(); i++ )
-            {
-               sampleMask[i] = '0' + ccmPair.at(k, i);
-            }
+            errors[begin / CHUNK_SIZE] = std::current_exception();
          }
+      });
 
-         // else just initialize empty sample mask
-         else
+      // write chunks to output file in order
+      for ( int i = 0; i < chunks.size(); ++i )
+      {
+         if ( errors[i] )
          {
-            sampleMask.fill('0');
+            std::rethrow_exception(errors[i]);
          }
 
-         // write cluster to output file
-         stream
-            << cmxPair.index().getX()
-            << "\t" << cmxPair.index().getY()
-            << "\t" << k
-            << "\t" << cmxPair.clusterSize()
-            << "\t" << numSamples
-            << "\t" << numMissing
-            << "\t" << numPostOutliers
-            << "\t" << numPreOutliers
-            << "\t" << numThreshold
-            << "\t" << correlation
-            << "\t" << sampleMask
-            << "\n";
+         if ( _output->write(texts[i]) != texts[i].size() )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("File IO Error"));
+            e.setDetails(tr("Failed writing to output file: %1").arg(_output->errorString()));
+            throw e;
+         }
       }
    }
-
-   // make sure writing output file worked
-   if ( stream.status() != QTextStream::Ok )
-   {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
-      throw e;
-   }
 }
 
 
@@ -141,3 +98,70 @@ void ExportCorrelationMatrix::initialize()
       throw e;
    }
 }
+
+
+
+
+
+
+void ExportCorrelationMatrix::formatClusters(const Pairwise::MatrixWindow& window, qint64 begin, int size, QByteArray* text) const
+{
+   const int sampleSize {_ccm->sampleSize()};
+
+   // allocate enough text for the largest possible line of every cluster
+   text->resize(size * (128 + sampleSize));
+   char* p {text->data()};
+   QByteArray sampleMask(sampleSize, '0');
+
+   for ( qint64 i = begin; i < begin + size; ++i )
+   {
+      Pairwise::Index index {window.index(i)};
+      float correlation;
+      memcpy(&correlation, window.data(i), sizeof(float));
+
+      // if there are multiple clusters then expand the packed sample mask and compute
+      // summary statistics, else just use an empty sample mask
+      int counts[16] {0};
+
+      if ( window.clusterData(i) )
+      {
+         TextIO::unpackMask(sampleMask.data(), window.clusterData(i), sampleSize);
+
+         for ( char c : sampleMask )
+         {
+            ++counts[c & 0x0F];
+         }
+      }
+      else
+      {
+         sampleMask.fill('0');
+      }
+
+      // write cluster to output text
+      p = TextIO::formatInt(p, index.getX());
+      *p++ = '\t';
+      p = TextIO::formatInt(p, index.getY());
+      *p++ = '\t';
+      p = TextIO::formatInt(p, window.cluster(i));
+      *p++ = '\t';
+      p = TextIO::formatInt(p, window.clusterSize(i));
+      *p++ = '\t';
+      p = TextIO::formatInt(p, counts[1]);
+      *p++ = '\t';
+      p = TextIO::formatInt(p, counts[9]);
+      *p++ = '\t';
+      p = TextIO::formatInt(p, counts[8]);
+      *p++ = '\t';
+      p = TextIO::formatInt(p, counts[7]);
+      *p++ = '\t';
+      p = TextIO::formatInt(p, counts[6]);
+      *p++ = '\t';
+      p = TextIO::formatFloat(p, correlation);
+      *p++ = '\t';
+      memcpy(p, sampleMask.constData(), sampleSize);
+      p += sampleSize;
+      *p++ = '\n';
+   }
+
+   text->resize(p - text->data());
+}
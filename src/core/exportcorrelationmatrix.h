@@ -4,6 +4,7 @@
 
 #include "ccmatrix.h"
 #include "correlationmatrix.h"
+#include "pairwise_matrixwindow.h"
 
 
 
@@ -17,6 +18,7 @@ public:
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
+   void formatClusters(const Pairwise::MatrixWindow& window, qint64 begin, int size, QByteArray* text) const;
    CCMatrix* _ccm {nullptr};
    CorrelationMatrix* _cmx {nullptr};
    QFile* _output {nullptr};
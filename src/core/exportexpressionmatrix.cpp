@@ -1,6 +1,20 @@
 #include "exportexpressionmatrix.h"
 #include "exportexpressionmatrix_input.h"
 #include "datafactory.h"
+#include "textio.h"
+
+#include <QtConcurrent>
+
+
+
+
+
+
+const QStringList ExportExpressionMatrix::FORMAT_NAMES
+{
+   "text"
+   ,"float32"
+};
 
 
 
@@ -21,80 +35,94 @@ void ExportExpressionMatrix::process(const EAbstractAnalytic::Block* result)
 {
    Q_UNUSED(result);
 
-   // use expression declaration
-   using Expression = ExpressionMatrix::Expression;
-   using Transform = ExpressionMatrix::Transform;
-
    // get gene names, sample names, and transform
-   EMetaArray geneNames = _input->getGeneNames().toArray();
    EMetaArray sampleNames = _input->getSampleNames().toArray();
-   Transform transform = _input->getTransform();
+   ExpressionMatrix::Transform transform = _input->getTransform();
 
-   // create text stream to output file
-   QTextStream stream(_output);
-   stream.setRealNumberPrecision(12);
+   QVector<QByteArray> geneNames;
+   for ( auto& geneName : _input->getGeneNames().toArray() )
+   {
+      geneNames.append(geneName.toString().toUtf8());
+   }
 
-   // write sample names
-   for ( int i = 0; i < _input->getSampleSize(); i++ )
+   // write sample names if this is a text file
+   if ( _format == Format::Text )
    {
-      stream << sampleNames.at(i).toString() << "\t";
+      QByteArray header;
+      for ( int i = 0; i < _input->getSampleSize(); i++ )
+      {
+         header.append(sampleNames.at(i).toString().toUtf8()).append('\t');
+      }
+      header.append('\n');
+
+      write(header);
    }
-   stream << "\n";
 
-   // write each gene to a line in output file
-   ExpressionMatrix::Gene gene(_input);
-   for ( int i = 0; i < _input->getGeneSize(); i++ )
+   // read genes in windows of rows, revert the transform of each window and either format
+   // it in parallel chunks of rows or write it as raw values
+   const int CHUNK_SIZE {64};
+   const int WINDOW_SIZE {16 * CHUNK_SIZE};
+   const int geneSize {_input->getGeneSize()};
+   const int sampleSize {_input->getSampleSize()};
+   QVector<Expression> expressions(WINDOW_SIZE * sampleSize);
+
+   for ( int window = 0; window < geneSize; window += WINDOW_SIZE )
    {
-      // load gene from expression matrix
-      gene.read(i);
+      const int windowSize {qMin(WINDOW_SIZE, geneSize - window)};
+      const qint64 size {(qint64)windowSize * sampleSize};
 
-      // write gene name
-      stream << geneNames.at(i).toString();
+      _input->readGenes(window, windowSize, expressions.data());
+      ExpressionMatrix::revertTransform(transform, expressions.data(), size);
 
-      // write expression values
-      for ( int j = 0; j < _input->getSampleSize(); j++ )
+      // write raw values in little-endian byte order
+      if ( _format == Format::Float32 )
       {
-         Expression value {gene.at(j)};
-
-         // if value is NAN use the no sample token
-         if ( std::isnan(value) )
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+         for ( qint64 i = 0; i < size; ++i )
          {
-            stream << "\t" << _noSampleToken;
+            quint32 word;
+            memcpy(&word, &expressions[i], sizeof(quint32));
+            word = qToLittleEndian(word);
+            memcpy(&expressions[i], &word, sizeof(quint32));
          }
+#endif
+         write(QByteArray::fromRawData(reinterpret_cast<const char*>(expressions.constData()), size * sizeof(Expression)));
+         continue;
+      }
 
-         // else this is a normal floating point expression
-         else
+      // format chunks of rows in parallel, saving the error of any chunk so it can be
+      // thrown from this thread
+      QVector<int> chunks;
+      for ( int i = 0; i < windowSize; i += CHUNK_SIZE )
+      {
+         chunks.append(i);
+      }
+      QVector<QByteArray> texts(chunks.size());
+      QVector<std::exception_ptr> errors(chunks.size());
+
+      QtConcurrent::blockingMap(chunks, [&](int& first)
+      {
+         try
          {
-            // apply transform and write value
-            switch (transform)
-            {
-            case Transform::None:
-               break;
-            case Transform::NLog:
-               value = exp(value);
-               break;
-            case Transform::Log2:
-               value = pow(2, value);
-               break;
-            case Transform::Log10:
-               value = pow(10, value);
-               break;
-            }
-
-            stream << "\t" << value;
+            formatGenes(geneNames, window + first, qMin(CHUNK_SIZE, windowSize - first),
+                        &expressions[first * sampleSize], &texts[first / CHUNK_SIZE]);
          }
-      }
+         catch ( ... )
+         {
+            errors[first / CHUNK_SIZE] = std::current_exception();
+         }
+      });
 
-      stream << "\n";
-   }
+      // write chunks to output file in order
+      for ( int i = 0; i < chunks.size(); ++i )
+      {
+         if ( errors[i] )
+         {
+            std::rethrow_exception(errors[i]);
+         }
 
-   // make sure writing output file worked
-   if ( stream.status() != QTextStream::Ok )
-   {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
-      throw e;
+         write(texts[i]);
+      }
    }
 }
 
@@ -123,3 +151,73 @@ void ExportExpressionMatrix::initialize()
       throw e;
    }
 }
+
+
+
+
+
+
+void ExportExpressionMatrix::formatGenes(const QVector<QByteArray>& geneNames, int index, int size, const Expression* expressions, QByteArray* text) const
+{
+   const int sampleSize {_input->getSampleSize()};
+   const QByteArray noSampleToken {_noSampleToken.toUtf8()};
+
+   // allocate enough text for the largest possible line of every gene
+   qint64 capacity {0};
+   for ( int i = 0; i < size; ++i )
+   {
+      capacity += geneNames.at(index + i).size() + (qint64)sampleSize * (32 + noSampleToken.size()) + 1;
+   }
+   text->resize(capacity);
+   char* p {text->data()};
+
+   for ( int i = 0; i < size; ++i )
+   {
+      // write gene name
+      const QByteArray& geneName {geneNames.at(index + i)};
+      memcpy(p, geneName.constData(), geneName.size());
+      p += geneName.size();
+
+      // write expression values
+      for ( int j = 0; j < sampleSize; ++j )
+      {
+         Expression value {expressions[i * sampleSize + j]};
+
+         *p++ = '\t';
+
+         // if value is NAN use the no sample token
+         if ( std::isnan(value) )
+         {
+            memcpy(p, noSampleToken.constData(), noSampleToken.size());
+            p += noSampleToken.size();
+         }
+
+         // else this is a normal floating point expression
+         else
+         {
+            p = TextIO::formatFloat(p, value, _precision);
+         }
+      }
+
+      *p++ = '\n';
+   }
+
+   text->resize(p - text->data());
+}
+
+
+
+
+
+
+void ExportExpressionMatrix::write(const QByteArray& data)
+{
+   // make sure writing output file worked
+   if ( _output->write(data) != data.size() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing to output file: %1").arg(_output->errorString()));
+      throw e;
+   }
+}
@@ -10,15 +10,26 @@ class ExportExpressionMatrix : public EAbstractAnalytic
 {
    Q_OBJECT
 public:
+   static const QStringList FORMAT_NAMES;
+   enum class Format
+   {
+      Text
+      ,Float32
+   };
    class Input;
    virtual int size() const override final;
    virtual void process(const EAbstractAnalytic::Block* result) override final;
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
+   using Expression = ExpressionMatrix::Expression;
+   void formatGenes(const QVector<QByteArray>& geneNames, int index, int size, const Expression* expressions, QByteArray* text) const;
+   void write(const QByteArray& data);
    ExpressionMatrix* _input {nullptr};
    QFile* _output {nullptr};
    QString _noSampleToken;
+   int _precision {12};
+   Format _format {Format::Text};
 };
 
 
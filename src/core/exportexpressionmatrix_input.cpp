@@ -33,6 +33,8 @@ EAbstractAnalytic::Input::Type ExportExpressionMatrix::Input::type(int index) co
    case InputData: return Type::DataIn;
    case OutputFile: return Type::FileOut;
    case NoSampleToken: return Type::String;
+   case Precision: return Type::Integer;
+   case OutputFormat: return Type::Selection;
    default: return Type::Boolean;
    }
 }
@@ -72,6 +74,27 @@ QVariant ExportExpressionMatrix::Input::data(int index, Role role) const
       case Role::WhatsThis: return tr("Expected token for expressions that have no value.");
       default: return QVariant();
       }
+   case Precision:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("precision");
+      case Role::Title: return tr("Precision:");
+      case Role::WhatsThis: return tr("Number of significant digits of each expression in text output.");
+      case Role::Default: return 12;
+      case Role::Minimum: return 1;
+      case Role::Maximum: return 17;
+      default: return QVariant();
+      }
+   case OutputFormat:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("format");
+      case Role::Title: return tr("Format:");
+      case Role::WhatsThis: return tr("Format of output file, either text or raw little-endian float32 values in row-major order.");
+      case Role::Default: return ExportExpressionMatrix::FORMAT_NAMES.first();
+      case Role::SelectionValues: return ExportExpressionMatrix::FORMAT_NAMES;
+      default: return QVariant();
+      }
    default: return QVariant();
    }
 }
@@ -88,6 +111,12 @@ void ExportExpressionMatrix::Input::set(int index, const QVariant& value)
    case NoSampleToken:
       _base->_noSampleToken = value.toString();
       break;
+   case Precision:
+      _base->_precision = value.toInt();
+      break;
+   case OutputFormat:
+      _base->_format = static_cast<Format>(ExportExpressionMatrix::FORMAT_NAMES.indexOf(value.toString()));
+      break;
    }
 }
 
@@ -13,6 +13,8 @@ public:
       InputData = 0
       ,OutputFile
       ,NoSampleToken
+      ,Precision
+      ,OutputFormat
       ,Total
    };
    explicit Input(ExportExpressionMatrix* parent);
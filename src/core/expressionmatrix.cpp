@@ -1,5 +1,7 @@
 #include "expressionmatrix.h"
 
+#include <cmath>
+
 
 
 
@@ -18,10 +20,21 @@ const QStringList ExpressionMatrix::TRANSFORM_NAMES
 
 
 
+const QStringList ExpressionMatrix::STORAGE_NAMES
+{
+   "float32"
+   ,"float16"
+};
+
+
+
+
+
+
 qint64 ExpressionMatrix::dataEnd() const
 {
    // calculate and return end of data
-   return DATA_OFFSET + ((qint64)_geneSize * (qint64)_sampleSize * sizeof(Expression));
+   return dataOffset() + ((qint64)_geneSize * (qint64)_sampleSize * expressionSize());
 }
 
 
@@ -31,9 +44,35 @@ qint64 ExpressionMatrix::dataEnd() const
 
 void ExpressionMatrix::readData()
 {
-   // read header
+   // read header, which is either the gene and sample size of a float32 matrix or the
+   // extended header of any other storage type
    seek(0);
-   stream() >> _geneSize >> _sampleSize;
+
+   qint32 first;
+   stream() >> first;
+
+   if ( first == EXTENDED_HEADER )
+   {
+      qint32 storage;
+      stream() >> storage >> _geneSize >> _sampleSize;
+
+      // make sure storage type is known
+      if ( storage < 0 || storage >= STORAGE_NAMES.size() )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("File IO Error"));
+         e.setDetails(tr("Expression matrix has unknown storage type %1.").arg(storage));
+         throw e;
+      }
+
+      _storage = static_cast<Storage>(storage);
+   }
+   else
+   {
+      _geneSize = first;
+      stream() >> _sampleSize;
+      _storage = Storage::Float32;
+   }
 }
 
 
@@ -47,8 +86,7 @@ void ExpressionMatrix::writeNewData()
    setMeta(EMetadata(EMetadata::Object));
 
    // initialize header
-   seek(0);
-   stream() << _geneSize << _sampleSize;
+   writeHeader();
 }
 
 
@@ -69,8 +107,7 @@ QAbstractTableModel* ExpressionMatrix::model()
 void ExpressionMatrix::finish()
 {
    // write header
-   seek(0);
-   stream() << _geneSize << _sampleSize;
+   writeHeader();
 }
 
 
@@ -174,10 +211,19 @@ QVariant ExpressionMatrix::data(const QModelIndex& index, int role) const
 
    // make input variable and seek to position of queried expression
    Expression value;
-   seek(DATA_OFFSET+(((index.row()*_sampleSize)+index.column())*sizeof(Expression)));
+   seek(dataOffset() + ((qint64)index.row() * _sampleSize + index.column()) * expressionSize());
 
    // read expression from file
-   stream() >> value;
+   if ( _storage == Storage::Float16 )
+   {
+      quint16 half;
+      stream() >> half;
+      value = fromHalf(half);
+   }
+   else
+   {
+      stream() >> value;
+   }
 
    // return expression
    return value;
@@ -188,7 +234,7 @@ QVariant ExpressionMatrix::data(const QModelIndex& index, int role) const
 
 
 
-void ExpressionMatrix::initialize(QStringList geneNames, QStringList sampleNames)
+void ExpressionMatrix::initialize(QStringList geneNames, QStringList sampleNames, Storage storage)
 {
    // create metadata array of gene names
    EMetaArray metaGeneNames;
@@ -210,9 +256,10 @@ void ExpressionMatrix::initialize(QStringList geneNames, QStringList sampleNames
    metaObject.insert("samples", metaSampleNames);
    setMeta(metaObject);
 
-   // set gene and sample size
+   // set gene and sample size and storage type
    _geneSize = geneNames.size();
    _sampleSize = sampleNames.size();
+   _storage = storage;
 }
 
 
@@ -222,8 +269,26 @@ void ExpressionMatrix::initialize(QStringList geneNames, QStringList sampleNames
 
 ExpressionMatrix::Transform ExpressionMatrix::getTransform() const
 {
+   // a matrix without a transform has not been transformed
    QString transformName {meta().toObject().at("transform").toString()};
-   return static_cast<Transform>(TRANSFORM_NAMES.indexOf(transformName));
+
+   if ( transformName.isEmpty() )
+   {
+      return Transform::None;
+   }
+
+   // make sure transform is known
+   int index {TRANSFORM_NAMES.indexOf(transformName)};
+
+   if ( index == -1 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Expression matrix has unknown transform %1.").arg(transformName));
+      throw e;
+   }
+
+   return static_cast<Transform>(index);
 }
 
 
@@ -245,6 +310,75 @@ void ExpressionMatrix::setTransform(ExpressionMatrix::Transform transform)
 
 
 
+void ExpressionMatrix::applyTransform(Transform transform, Expression* expressions, qint64 size)
+{
+   // apply transform to all expressions in one pass, with the switch outside of the loop
+   // so that it is not evaluated for every expression; missing values are NAN and stay
+   // NAN under every transform
+   switch (transform)
+   {
+   case Transform::None:
+      break;
+   case Transform::NLog:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::log(expressions[i]);
+      }
+      break;
+   case Transform::Log2:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::log2(expressions[i]);
+      }
+      break;
+   case Transform::Log10:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::log10(expressions[i]);
+      }
+      break;
+   }
+}
+
+
+
+
+
+
+void ExpressionMatrix::revertTransform(Transform transform, Expression* expressions, qint64 size)
+{
+   // revert transform of all expressions in one pass, in double precision as the inverse
+   // functions are sensitive to rounding of their argument
+   switch (transform)
+   {
+   case Transform::None:
+      break;
+   case Transform::NLog:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::exp((double)expressions[i]);
+      }
+      break;
+   case Transform::Log2:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::exp2((double)expressions[i]);
+      }
+      break;
+   case Transform::Log10:
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         expressions[i] = std::pow(10.0, (double)expressions[i]);
+      }
+      break;
+   }
+}
+
+
+
+
+
+
 qint64 ExpressionMatrix::getRawSize() const
 {
    return (qint64)_geneSize * (qint64)_sampleSize;
@@ -265,10 +399,7 @@ ExpressionMatrix::Expression* ExpressionMatrix::dumpRawData() const
 
    // create new floating point array and populate with all gene expressions
    Expression* ret {new Expression[getRawSize()]};
-   for (int i = 0; i < _geneSize ;++i)
-   {
-      readGene(i,&ret[i*_sampleSize]);
-   }
+   readGenes(0,_geneSize,ret);
 
    // return new float array
    return ret;
@@ -279,9 +410,45 @@ ExpressionMatrix::Expression* ExpressionMatrix::dumpRawData() const
 
 
 
-EMetadata ExpressionMatrix::getGeneNames() const
+void ExpressionMatrix::readGenes(int index, int size, Expression* expressions) const
 {
-   return meta().toObject().at("genes");
+   // make sure given range of genes is within range
+   if ( index < 0 || size < 0 || index + size > _geneSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Domain Error"));
+      e.setDetails(tr("Attempting to read genes %1 to %2 when maximum is %3.").arg(index)
+                   .arg(index+size-1).arg(_geneSize-1));
+      throw e;
+   }
+
+   // read and decode expressions stored as float16 in windows of genes
+   if ( _storage == Storage::Float16 )
+   {
+      const int windowSize {qMax(1, HALF_BUFFER_SIZE / qMax(1, _sampleSize))};
+      QVector<quint16> halves(qMin(size, windowSize) * _sampleSize);
+
+      for ( int window = 0; window < size; window += windowSize )
+      {
+         const int windowGenes {qMin(windowSize, size - window)};
+         Expression* windowExpressions {&expressions[(qint64)window * _sampleSize]};
+
+         readHalfGenes(index + window, windowGenes, halves.data());
+
+         for ( int i = 0; i < windowGenes * _sampleSize; ++i )
+         {
+            windowExpressions[i] = fromHalf(halves.at(i));
+         }
+      }
+
+      return;
+   }
+
+   // seek to position of beginning of first gene's expressions
+   seek(dataOffset() + ((qint64)index * _sampleSize * sizeof(Expression)));
+
+   // read in all expressions of the genes as one block
+   readBlock(reinterpret_cast<char*>(expressions), (qint64)size * _sampleSize * sizeof(Expression));
 }
 
 
@@ -289,9 +456,63 @@ EMetadata ExpressionMatrix::getGeneNames() const
 
 
 
-EMetadata ExpressionMatrix::getSampleNames() const
+void ExpressionMatrix::writeGenes(int index, int size, const Expression* expressions)
 {
-   return meta().toObject().at("samples");
+   // make sure given range of genes is within range
+   if ( index < 0 || size < 0 || index + size > _geneSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Domain Error"));
+      e.setDetails(tr("Attempting to write genes %1 to %2 when maximum is %3.").arg(index)
+                   .arg(index+size-1).arg(_geneSize-1));
+      throw e;
+   }
+
+   const qint64 count {(qint64)size * _sampleSize};
+
+   // encode and write expressions stored as float16 in windows of genes
+   if ( _storage == Storage::Float16 )
+   {
+      // make sure every expression can be stored before anything is written, missing
+      // values stay NAN and infinities stay infinite
+      for ( qint64 i = 0; i < count; ++i )
+      {
+         if ( std::isfinite(expressions[i]) && std::fabs(expressions[i]) > HALF_MAX )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Domain Error"));
+            e.setDetails(tr("Expression %1 is out of the range of float16 storage, a log transform "
+                            "may bring it within range.").arg(expressions[i]));
+            throw e;
+         }
+      }
+
+      const int windowSize {qMax(1, HALF_BUFFER_SIZE / qMax(1, _sampleSize))};
+      QVector<quint16> halves(qMin(size, windowSize) * _sampleSize);
+
+      seek(dataOffset() + ((qint64)index * _sampleSize * expressionSize()));
+
+      for ( int window = 0; window < size; window += windowSize )
+      {
+         const int windowCount {qMin(windowSize, size - window) * _sampleSize};
+         const Expression* windowExpressions {&expressions[(qint64)window * _sampleSize]};
+
+         for ( int i = 0; i < windowCount; ++i )
+         {
+            halves[i] = toHalf(windowExpressions[i]);
+         }
+
+         writeBlock(reinterpret_cast<const char*>(halves.constData()), (qint64)windowCount * sizeof(quint16));
+      }
+
+      return;
+   }
+
+   // seek to position of beginning of first gene's expressions
+   seek(dataOffset() + ((qint64)index * _sampleSize * sizeof(Expression)));
+
+   // overwrite all expressions of the genes as one block
+   writeBlock(reinterpret_cast<const char*>(expressions), count * sizeof(Expression));
 }
 
 
@@ -299,16 +520,32 @@ EMetadata ExpressionMatrix::getSampleNames() const
 
 
 
-void ExpressionMatrix::readGene(int index, Expression* expressions) const
+void ExpressionMatrix::readHalfGenes(int index, int size, quint16* halves) const
 {
-   // seek to position of beginning of gene's expressions
-   seek(DATA_OFFSET + (index * _sampleSize * sizeof(Expression)));
+   // make sure matrix is stored as float16 and given range of genes is within range
+   if ( _storage != Storage::Float16 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Domain Error"));
+      e.setDetails(tr("Attempting to read float16 expressions of a matrix stored as %1.")
+                   .arg(STORAGE_NAMES.at(static_cast<int>(_storage))));
+      throw e;
+   }
 
-   // read in all expressions for gene as block of floats
-   for ( int i = 0; i < _sampleSize; ++i )
+   if ( index < 0 || size < 0 || index + size > _geneSize )
    {
-      stream() >> expressions[i];
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Domain Error"));
+      e.setDetails(tr("Attempting to read genes %1 to %2 when maximum is %3.").arg(index)
+                   .arg(index+size-1).arg(_geneSize-1));
+      throw e;
    }
+
+   // seek to position of beginning of first gene's expressions
+   seek(dataOffset() + ((qint64)index * _sampleSize * expressionSize()));
+
+   // read in all expressions of the genes as one block
+   readBlock(reinterpret_cast<char*>(halves), (qint64)size * _sampleSize * sizeof(quint16));
 }
 
 
@@ -316,16 +553,221 @@ void ExpressionMatrix::readGene(int index, Expression* expressions) const
 
 
 
-void ExpressionMatrix::writeGene(int index, const Expression* expressions)
+quint16 ExpressionMatrix::toHalf(Expression value)
 {
-   // seek to position of beginning of gene's expressions
-   seek(DATA_OFFSET + (index * _sampleSize * sizeof(Expression)));
+   // convert float to IEEE half precision, rounding to nearest even
+   quint32 bits;
+   memcpy(&bits, &value, sizeof(quint32));
+
+   const quint16 sign = (bits >> 16) & 0x8000;
+   const int exponent = (bits >> 23) & 0xFF;
+   quint32 mantissa = bits & 0x7FFFFF;
+
+   // keep NAN and infinity, NAN stays NAN so missing values are preserved
+   if ( exponent == 0xFF )
+   {
+      return sign | 0x7C00 | (mantissa ? 0x0200 : 0);
+   }
+
+   const int halfExponent = exponent - 127 + 15;
 
-   // overwrite all expressions for gene as block of floats
-   for ( int i = 0; i < _sampleSize; ++i )
+   // overflow to infinity
+   if ( halfExponent >= 31 )
    {
-      stream() << expressions[i];
+      return sign | 0x7C00;
    }
+
+   // underflow to a subnormal number or zero
+   if ( halfExponent <= 0 )
+   {
+      if ( halfExponent < -10 )
+      {
+         return sign;
+      }
+
+      mantissa |= 0x800000;
+
+      const int shift = 14 - halfExponent;
+      quint32 half = mantissa >> shift;
+      const quint32 rest = mantissa & ((1u << shift) - 1);
+      const quint32 halfway = 1u << (shift - 1);
+
+      if ( rest > halfway || (rest == halfway && (half & 1)) )
+      {
+         ++half;
+      }
+
+      return sign | half;
+   }
+
+   // normal number, where rounding may carry into the exponent
+   quint32 half = (halfExponent << 10) | (mantissa >> 13);
+   const quint32 rest = mantissa & 0x1FFF;
+
+   if ( rest > 0x1000 || (rest == 0x1000 && (half & 1)) )
+   {
+      ++half;
+   }
+
+   return sign | half;
+}
+
+
+
+
+
+
+ExpressionMatrix::Expression ExpressionMatrix::fromHalf(quint16 half)
+{
+   // convert IEEE half precision to float, which is exact
+   const quint32 sign = (quint32)(half & 0x8000) << 16;
+   const int exponent = (half >> 10) & 0x1F;
+   quint32 mantissa = half & 0x3FF;
+   quint32 bits;
+
+   if ( exponent == 0x1F )
+   {
+      bits = sign | 0x7F800000 | (mantissa << 13);
+   }
+   else if ( exponent == 0 && mantissa == 0 )
+   {
+      bits = sign;
+   }
+   else if ( exponent == 0 )
+   {
+      // normalize subnormal number
+      int shift = 0;
+      while ( !(mantissa & 0x400) )
+      {
+         mantissa <<= 1;
+         ++shift;
+      }
+
+      bits = sign | ((quint32)(127 - 15 - shift + 1) << 23) | ((mantissa & 0x3FF) << 13);
+   }
+   else
+   {
+      bits = sign | ((quint32)(exponent - 15 + 127) << 23) | (mantissa << 13);
+   }
+
+   Expression value;
+   memcpy(&value, &bits, sizeof(quint32));
+
+   return value;
+}
+
+
+
+
+
+
+void ExpressionMatrix::readBlock(char* data, qint64 bytes) const
+{
+   // read a block of expressions with one raw read through the device of the data stream
+   if ( stream().device()->read(data, bytes) != bytes )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed reading expressions: %1").arg(stream().device()->errorString()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+void ExpressionMatrix::writeBlock(const char* data, qint64 bytes)
+{
+   // write a block of expressions with one raw write through the device of the data stream
+   if ( stream().device()->write(data, bytes) != bytes )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing expressions: %1").arg(stream().device()->errorString()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+void ExpressionMatrix::writeHeader()
+{
+   // write the short header of float32 matrices so they stay readable by older versions
+   seek(0);
+
+   if ( _storage == Storage::Float32 )
+   {
+      stream() << _geneSize << _sampleSize;
+   }
+   else
+   {
+      stream() << EXTENDED_HEADER << (qint32)_storage << _geneSize << _sampleSize;
+   }
+}
+
+
+
+
+
+
+qint64 ExpressionMatrix::dataOffset() const
+{
+   return (_storage == Storage::Float32) ? DATA_OFFSET : EXTENDED_DATA_OFFSET;
+}
+
+
+
+
+
+
+int ExpressionMatrix::expressionSize() const
+{
+   return (_storage == Storage::Float16) ? sizeof(quint16) : sizeof(Expression);
+}
+
+
+
+
+
+
+EMetadata ExpressionMatrix::getGeneNames() const
+{
+   return meta().toObject().at("genes");
+}
+
+
+
+
+
+
+EMetadata ExpressionMatrix::getSampleNames() const
+{
+   return meta().toObject().at("samples");
+}
+
+
+
+
+
+
+void ExpressionMatrix::readGene(int index, Expression* expressions) const
+{
+   readGenes(index,1,expressions);
+}
+
+
+
+
+
+
+void ExpressionMatrix::writeGene(int index, const Expression* expressions)
+{
+   writeGenes(index,1,expressions);
 }
 
 
@@ -17,6 +17,12 @@ public:
       ,Log2
       ,Log10
    };
+   static const QStringList STORAGE_NAMES;
+   enum class Storage
+   {
+      Float32
+      ,Float16
+   };
    class Gene;
    virtual qint64 dataEnd() const override final;
    virtual void readData() override final;
@@ -27,21 +33,43 @@ public:
    int rowCount(const QModelIndex& parent) const;
    int columnCount(const QModelIndex& parent) const;
    QVariant data(const QModelIndex& index, int role) const;
-   void initialize(QStringList geneNames, QStringList sampleNames);
+   void initialize(QStringList geneNames, QStringList sampleNames, Storage storage = Storage::Float32);
    Transform getTransform() const;
    void setTransform(Transform scale);
+   static void applyTransform(Transform transform, Expression* expressions, qint64 size);
+   static void revertTransform(Transform transform, Expression* expressions, qint64 size);
    qint32 getGeneSize() const { return _geneSize; }
    qint32 getSampleSize() const { return _sampleSize; }
+   Storage getStorage() const { return _storage; }
    qint64 getRawSize() const;
    Expression* dumpRawData() const;
+   void readGenes(int index, int size, Expression* expressions) const;
+   void writeGenes(int index, int size, const Expression* expressions);
+   void readHalfGenes(int index, int size, quint16* halves) const;
+   static quint16 toHalf(Expression value);
+   static Expression fromHalf(quint16 half);
    EMetadata getGeneNames() const;
    EMetadata getSampleNames() const;
 private:
    void readGene(int index, Expression* expressions) const;
    void writeGene(int index, const Expression* expressions);
+   void writeHeader();
+   void readBlock(char* data, qint64 bytes) const;
+   void writeBlock(const char* data, qint64 bytes);
+   qint64 dataOffset() const;
+   int expressionSize() const;
    static const int DATA_OFFSET {8};
+   // matrices stored in anything but float32 have an extended header, which begins with
+   // this marker in place of the gene size followed by the storage type
+   static const qint32 EXTENDED_HEADER {-1};
+   static const int EXTENDED_DATA_OFFSET {16};
+   // largest magnitude of an expression stored as float16
+   static constexpr float HALF_MAX {65504};
+   // number of float16 expressions converted at a time when reading or writing genes
+   static const int HALF_BUFFER_SIZE {1 << 20};
    qint32 _geneSize {0};
    qint32 _sampleSize {0};
+   Storage _storage {Storage::Float32};
 };
 
 
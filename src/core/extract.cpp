@@ -1,6 +1,11 @@
 #include "extract.h"
 #include "extract_input.h"
 #include "datafactory.h"
+#include "correlationmatrix_thresholdindex.h"
+#include "textio.h"
+
+#include <QtConcurrent>
+#include <QtEndian>
 
 
 
@@ -8,6 +13,12 @@ using namespace std;
 
 
 
+const char Extract::BINARY_MAGIC[8] {'K','I','N','C','E','D','G','E'};
+static_assert(sizeof(Extract::BinaryHeader) == 64, "binary header must have no padding");
+static_assert(sizeof(Extract::BinaryEdge) == 36, "binary edge must have no padding");
+
+
+
 
 
 
@@ -25,263 +36,515 @@ void Extract::process(const EAbstractAnalytic::Block* result)
 {
    Q_UNUSED(result);
 
-   // initialize pair iterators
-   CorrelationMatrix::Pair cmxPair(_cmx);
-   CCMatrix::Pair ccmPair(_ccm);
-
    // get gene names
-   EMetaArray geneNames {_cmx->geneNames().toArray()};
-
-   // initialize workspace
-   QString sampleMask(_ccm->sampleSize(), '0');
-
-   // create text stream to output file and write until end reached
-   QTextStream stream(_output);
-   stream.setRealNumberPrecision(6);
-
-   // write header to file
-   stream
-      << "Source"
-      << "\t" << "Target"
-      << "\t" << "sc"
-      << "\t" << "Interaction"
-      << "\t" << "Cluster"
-      << "\t" << "Num_Clusters"
-      << "\t" << "Cluster_Samples"
-      << "\t" << "Missing_Samples"
-      << "\t" << "Cluster_Outliers"
-      << "\t" << "Pair_Outliers"
-      << "\t" << "Too_Low"
-      << "\t" << "Samples"
-      << "\n";
-
-   // increment through all gene pairs
-   while ( cmxPair.hasNext() )
+   QVector<QByteArray> geneNames;
+   for ( auto& geneName : _cmx->geneNames().toArray() )
+   {
+      geneNames.append(geneName.toString().toUtf8());
+   }
+
+   // read which expressions are missing so sample masks of pairs with one cluster can be
+   // determined without reading expression data for every pair
+   QVector<quint64> missing {readMissing()};
+
+   // write header to text file
+   if ( _output )
+   {
+      write(_output,
+         "Source"
+         "\t" "Target"
+         "\t" "sc"
+         "\t" "Interaction"
+         "\t" "Cluster"
+         "\t" "Num_Clusters"
+         "\t" "Cluster_Samples"
+         "\t" "Missing_Samples"
+         "\t" "Cluster_Outliers"
+         "\t" "Pair_Outliers"
+         "\t" "Too_Low"
+         "\t" "Samples"
+         "\n");
+   }
+
+   // write binary header and gene names, leaving the edge count to be filled in once
+   // every edge has been written
+   qint64 edgesOffset {0};
+   qint64 edgeSize {0};
+
+   if ( _binary )
    {
-      // read next gene pair
-      cmxPair.readNext();
+      QByteArray names {makeBinaryNames(geneNames)};
+      edgesOffset = sizeof(BinaryHeader) + names.size();
+
+      write(_binary, makeBinaryHeader(0, edgesOffset));
+      write(_binary, names);
+   }
 
-      if ( cmxPair.clusterSize() > 1 )
+   // write graphml header and each node to graphml file
+   if ( _graphml )
+   {
+      QByteArray header
+      {
+         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\"\n"
+         "    xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
+         "    xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n"
+         "  <graph id=\"G\" edgedefault=\"undirected\">\n"
+      };
+
+      for ( auto& id : geneNames )
       {
-         ccmPair.read(cmxPair.index());
+         header.append("    <node id=\"").append(id).append("\"/>\n");
       }
 
-      // write gene pair data to output file
-      for ( int k = 0; k < cmxPair.clusterSize(); k++ )
+      write(_graphml, header);
+   }
+
+   // read the correlation matrix in windows of raw items, along with the cluster matrix
+   // items of the same pairs, and format the edges of each window in parallel chunks which
+   // are written in order
+   const int CHUNK_SIZE {4096};
+   Pairwise::MatrixWindow window(_cmx, _ccm, 16 * CHUNK_SIZE);
+
+   // use only the ranges of the correlation matrix which may contain correlations within
+   // the thresholds if there is a threshold index, otherwise use the whole matrix
+   QVector<CorrelationMatrix::ThresholdIndex::Block> ranges {{0, _cmx->clusterSize(), 0, 1}};
+
+   if ( _index )
+   {
+      CorrelationMatrix::ThresholdIndex index(_cmx);
+      index.load(_index);
+      ranges = index.select(_minCorrelation, _maxCorrelation);
+   }
+
+   for ( auto& range : ranges )
+   {
+      window.setRange(range.begin, range.begin + range.size);
+
+      while ( window.next() )
       {
-         auto& source {geneNames.at(cmxPair.index().getX()).toString()};
-         auto& target {geneNames.at(cmxPair.index().getY()).toString()};
-         float correlation {cmxPair.at(k, 0)};
-         QString interaction {"co"};
-         int numSamples {0};
-         int numMissing {0};
-         int numPostOutliers {0};
-         int numPreOutliers {0};
-         int numThreshold {0};
-
-         // exclude cluster if correlation is not within thresholds
-         if ( fabs(correlation) < _minCorrelation || _maxCorrelation < fabs(correlation) )
+         const qint64 size {window.size()};
+
+         // format chunks of the window in parallel, saving the error of any chunk so it can
+         // be thrown from this thread
+         QVector<int> chunks;
+         for ( int i = 0; i < size; i += CHUNK_SIZE )
          {
-            continue;
+            chunks.append(i);
          }
+         QVector<QByteArray> texts(chunks.size());
+         QVector<QByteArray> graphmls(chunks.size());
+         QVector<QByteArray> binaries(chunks.size());
+         QVector<std::exception_ptr> errors(chunks.size());
 
-         // if there are multiple clusters then use cluster data
-         if ( cmxPair.clusterSize() > 1 )
+         QtConcurrent::blockingMap(chunks, [&](int& begin)
          {
-            // compute summary statistics
-            for ( int i = 0; i < _ccm->sampleSize(); i++ )
+            try
             {
-               switch ( ccmPair.at(k, i) )
-               {
-               case 1:
-                  numSamples++;
-                  break;
-               case 6:
-                  numThreshold++;
-                  break;
-               case 7:
-                  numPreOutliers++;
-                  break;
-               case 8:
-                  numPostOutliers++;
-                  break;
-               case 9:
-                  numMissing++;
-                  break;
-               }
+               int index {begin / CHUNK_SIZE};
+               formatEdges(window, begin, qMin((qint64)CHUNK_SIZE, size - begin), geneNames, missing,
+                           _output ? &texts[index] : nullptr,
+                           _graphml ? &graphmls[index] : nullptr,
+                           _binary ? &binaries[index] : nullptr);
             }
-
-            // write sample mask to string
-            for ( int i = 0; i < _ccm->sampleSize(); i++ )
+            catch ( ... )
             {
-               sampleMask[i] = '0' + ccmPair.at(k, i);
+               errors[begin / CHUNK_SIZE] = std::current_exception();
             }
-         }
+         });
 
-         // otherwise use expression data
-         else
+         // write chunks to output files in order
+         for ( int i = 0; i < chunks.size(); ++i )
          {
-            // read in gene expressions
-            ExpressionMatrix::Gene gene1(_emx);
-            ExpressionMatrix::Gene gene2(_emx);
+            if ( errors[i] )
+            {
+               std::rethrow_exception(errors[i]);
+            }
+
+            if ( _output )
+            {
+               write(_output, texts[i]);
+            }
 
-            gene1.read(cmxPair.index().getX());
-            gene2.read(cmxPair.index().getY());
+            if ( _graphml )
+            {
+               write(_graphml, graphmls[i]);
+            }
 
-            // determine sample mask from expression data
-            for ( int i = 0; i < _emx->getSampleSize(); ++i )
+            if ( _binary )
             {
-               if ( isnan(gene1.at(i)) || isnan(gene2.at(i)) )
-               {
-                  sampleMask[i] = '9';
-               }
-               else
-               {
-                  sampleMask[i] = '1';
-               }
+               write(_binary, binaries[i]);
+               edgeSize += binaries[i].size() / binaryRecordSize();
             }
          }
+      }
+   }
+
+   // write footer to graphml file
+   if ( _graphml )
+   {
+      write(_graphml,
+         "  </graph>\n"
+         "</graphml>\n");
+   }
 
-         // write cluster to output file
-         stream
-            << source
-            << "\t" << target
-            << "\t" << correlation
-            << "\t" << interaction
-            << "\t" << k
-            << "\t" << cmxPair.clusterSize()
-            << "\t" << numSamples
-            << "\t" << numMissing
-            << "\t" << numPostOutliers
-            << "\t" << numPreOutliers
-            << "\t" << numThreshold
-            << "\t" << sampleMask
-            << "\n";
+   // rewrite binary header with the number of edges
+   if ( _binary )
+   {
+      if ( !_binary->seek(0) )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("File IO Error"));
+         e.setDetails(tr("Failed seeking in binary output file: %1").arg(_binary->errorString()));
+         throw e;
       }
+
+      write(_binary, makeBinaryHeader(edgeSize, edgesOffset));
    }
+}
 
-   // make sure writing output file worked
-   if ( stream.status() != QTextStream::Ok )
+
+
+
+
+
+EAbstractAnalytic::Input* Extract::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void Extract::initialize()
+{
+   if ( !_emx || !_ccm || !_cmx || (!_output && !_binary) )
    {
       E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
       throw e;
    }
+}
+
 
-   // reset gene pair iterator
-   cmxPair.reset();
 
-   // create text stream to graphml file and write until end reached
-   stream.setDevice(_graphml);
 
-   // write header to file
-   stream
-      << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
-      << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\"\n"
-      << "    xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
-      << "    xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n"
-      << "  <graph id=\"G\" edgedefault=\"undirected\">\n";
 
-   // write each node to file
-   for ( int i = 0; i < _cmx->geneSize(); i++ )
+
+QVector<quint64> Extract::readMissing() const
+{
+   // build a bit for every expression which is set if the expression is missing, with the
+   // bits of each gene starting at a new word
+   const int geneSize {_emx->getGeneSize()};
+   const int sampleSize {_emx->getSampleSize()};
+   const int wordSize {(sampleSize + 63) / 64};
+   QVector<quint64> missing(geneSize * wordSize, 0);
+
+   // read genes in windows of rows with one block read each
+   const int WINDOW_SIZE {1024};
+   QVector<ExpressionMatrix::Expression> expressions(WINDOW_SIZE * sampleSize);
+
+   for ( int window = 0; window < geneSize; window += WINDOW_SIZE )
    {
-      auto& id {geneNames.at(i).toString()};
+      const int windowSize {qMin(WINDOW_SIZE, geneSize - window)};
+
+      _emx->readGenes(window, windowSize, expressions.data());
 
-      stream << "    <node id=\"" << id << "\"/>\n";
+      for ( int i = 0; i < windowSize; ++i )
+      {
+         quint64* words {&missing[(window + i) * wordSize]};
+
+         for ( int j = 0; j < sampleSize; ++j )
+         {
+            if ( std::isnan(expressions[i * sampleSize + j]) )
+            {
+               words[j / 64] |= 1ull << (j % 64);
+            }
+         }
+      }
    }
 
-   // increment through all gene pairs
-   while ( cmxPair.hasNext() )
+   return missing;
+}
+
+
+
+
+
+
+int Extract::binaryRecordSize() const
+{
+   // each record is the fixed edge fields followed by the optional packed sample mask,
+   // padded so every record stays 4-byte aligned
+   int maskSize {_binaryMasks ? (_ccm->sampleSize() + 1) / 2 : 0};
+
+   return (sizeof(BinaryEdge) + maskSize + 3) & ~3;
+}
+
+
+
+
+
+
+QByteArray Extract::makeBinaryHeader(qint64 edgeSize, qint64 edgesOffset) const
+{
+   BinaryHeader header;
+   memset(&header, 0, sizeof(BinaryHeader));
+   memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+   header.version = qToLittleEndian(BINARY_VERSION);
+   header.recordSize = qToLittleEndian((quint32)binaryRecordSize());
+   header.geneSize = qToLittleEndian((qint32)_cmx->geneSize());
+   header.sampleSize = qToLittleEndian((qint32)_ccm->sampleSize());
+   header.maskSize = qToLittleEndian((qint32)(_binaryMasks ? (_ccm->sampleSize() + 1) / 2 : 0));
+   header.edgeSize = qToLittleEndian(edgeSize);
+   header.namesOffset = qToLittleEndian((qint64)sizeof(BinaryHeader));
+   header.edgesOffset = qToLittleEndian(edgesOffset);
+
+   return QByteArray(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+}
+
+
+
+
+
+
+QByteArray Extract::makeBinaryNames(const QVector<QByteArray>& geneNames) const
+{
+   // write the offset of every name and the end of the last name, relative to the start
+   // of the names which follow the offsets, and pad the table to 8 bytes so the edge
+   // records which follow it are aligned
+   QByteArray offsets((geneNames.size() + 1) * sizeof(qint64), 0);
+   QByteArray names;
+   qint64 offset {0};
+
+   for ( int i = 0; i <= geneNames.size(); ++i )
    {
-      // read next gene pair
-      cmxPair.readNext();
+      qint64 word {qToLittleEndian(offset)};
+      memcpy(offsets.data() + i * sizeof(qint64), &word, sizeof(qint64));
 
-      if ( cmxPair.clusterSize() > 1 )
+      if ( i < geneNames.size() )
       {
-         ccmPair.read(cmxPair.index());
+         names.append(geneNames.at(i));
+         offset += geneNames.at(i).size();
       }
+   }
+
+   names.append(QByteArray((8 - names.size() % 8) % 8, 0));
+
+   return offsets.append(names);
+}
+
+
+
+
+
+
+void Extract::formatEdges(const Pairwise::MatrixWindow& window, qint64 begin, int size, const QVector<QByteArray>& geneNames, const QVector<quint64>& missing, QByteArray* text, QByteArray* graphml, QByteArray* binary) const
+{
+   const int sampleSize {_ccm->sampleSize()};
+   const int wordSize {(sampleSize + 63) / 64};
+
+   // allocate enough text for the largest possible line of every edge
+   qint64 capacity {0};
+   for ( qint64 i = begin; (text || graphml) && i < begin + size; ++i )
+   {
+      Pairwise::Index index {window.index(i)};
+      capacity += geneNames.at(index.getX()).size() + geneNames.at(index.getY()).size() + 128 + sampleSize;
+   }
+
+   char* p {nullptr};
+   char* g {nullptr};
+   char* b {nullptr};
+
+   if ( text )
+   {
+      text->resize(capacity);
+      p = text->data();
+   }
+
+   if ( graphml )
+   {
+      graphml->resize(capacity);
+      g = graphml->data();
+   }
+
+   // allocate a zeroed record for every edge so padding is always written as zeros
+   const int recordSize {binaryRecordSize()};
+   const int maskSize {_binaryMasks ? (sampleSize + 1) / 2 : 0};
 
-      // write gene pair edges to file
-      for ( int k = 0; k < cmxPair.clusterSize(); k++ )
+   if ( binary )
+   {
+      binary->fill(0, size * recordSize);
+      b = binary->data();
+   }
+
+   // only build sample masks of pairs with one cluster if they are written somewhere
+   const bool needMask {text || graphml || maskSize > 0};
+
+   QByteArray sampleMask(sampleSize, '0');
+
+   static const QByteArray EDGE_SOURCE {"    <edge source=\""};
+   static const QByteArray EDGE_TARGET {"\" target=\""};
+   static const QByteArray EDGE_SAMPLES {"\" samples=\""};
+   static const QByteArray EDGE_END {"\"/>\n"};
+
+   auto append = [](char* p, const QByteArray& data)
+   {
+      memcpy(p, data.constData(), data.size());
+      return p + data.size();
+   };
+
+   for ( qint64 i = begin; i < begin + size; ++i )
+   {
+      Pairwise::Index index {window.index(i)};
+      float correlation;
+      memcpy(&correlation, window.data(i), sizeof(float));
+
+      // exclude cluster if correlation is not within thresholds
+      if ( fabs(correlation) < _minCorrelation || _maxCorrelation < fabs(correlation) )
       {
-         auto& source {geneNames.at(cmxPair.index().getX()).toString()};
-         auto& target {geneNames.at(cmxPair.index().getY()).toString()};
-         float correlation {cmxPair.at(k, 0)};
+         continue;
+      }
 
-         // exclude edge if correlation is not within thresholds
-         if ( fabs(correlation) < _minCorrelation || _maxCorrelation < fabs(correlation) )
-         {
-            continue;
-         }
+      // if there are multiple clusters then use cluster data
+      int counts[16] {0};
 
-         // if there are multiple clusters then use cluster data
-         if ( cmxPair.clusterSize() > 1 )
+      if ( window.clusterSize(i) > 1 )
+      {
+         if ( window.clusterData(i) )
          {
-            // write sample mask to string
-            for ( int i = 0; i < _ccm->sampleSize(); i++ )
+            TextIO::unpackMask(sampleMask.data(), window.clusterData(i), sampleSize);
+
+            for ( char c : sampleMask )
             {
-               sampleMask[i] = '0' + ccmPair.at(k, i);
+               ++counts[c & 0x0F];
             }
          }
-
-         // otherwise use expression data
          else
          {
-            // read in gene expressions
-            ExpressionMatrix::Gene gene1(_emx);
-            ExpressionMatrix::Gene gene2(_emx);
+            sampleMask.fill('0');
+         }
+      }
+
+      // otherwise use missing expressions of both genes
+      else if ( needMask )
+      {
+         const quint64* wordsX {&missing[index.getX() * wordSize]};
+         const quint64* wordsY {&missing[index.getY() * wordSize]};
+
+         for ( int j = 0; j < sampleSize; ++j )
+         {
+            bool isMissing {(((wordsX[j / 64] | wordsY[j / 64]) >> (j % 64)) & 1) != 0};
+
+            sampleMask[j] = isMissing ? '9' : '1';
+         }
+      }
+
+      // write cluster to output text
+      const QByteArray& source {geneNames.at(index.getX())};
+      const QByteArray& target {geneNames.at(index.getY())};
+
+      if ( p )
+      {
+         p = append(p, source);
+         *p++ = '\t';
+         p = append(p, target);
+         *p++ = '\t';
+         p = TextIO::formatFloat(p, correlation);
+         memcpy(p, "\tco\t", 4);
+         p += 4;
+         p = TextIO::formatInt(p, window.cluster(i));
+         *p++ = '\t';
+         p = TextIO::formatInt(p, window.clusterSize(i));
+         *p++ = '\t';
+         p = TextIO::formatInt(p, counts[1]);
+         *p++ = '\t';
+         p = TextIO::formatInt(p, counts[9]);
+         *p++ = '\t';
+         p = TextIO::formatInt(p, counts[8]);
+         *p++ = '\t';
+         p = TextIO::formatInt(p, counts[7]);
+         *p++ = '\t';
+         p = TextIO::formatInt(p, counts[6]);
+         *p++ = '\t';
+         p = append(p, sampleMask);
+         *p++ = '\n';
+      }
 
-            gene1.read(cmxPair.index().getX());
-            gene2.read(cmxPair.index().getY());
+      // write edge to binary record
+      if ( b )
+      {
+         quint32 correlationBits;
+         memcpy(&correlationBits, &correlation, sizeof(float));
+
+         BinaryEdge edge;
+         edge.source = qToLittleEndian((qint32)index.getX());
+         edge.target = qToLittleEndian((qint32)index.getY());
+         correlationBits = qToLittleEndian(correlationBits);
+         memcpy(&edge.correlation, &correlationBits, sizeof(float));
+         edge.cluster = window.cluster(i);
+         edge.clusterSize = window.clusterSize(i);
+         edge.reserved = 0;
+         edge.samples = qToLittleEndian((qint32)counts[1]);
+         edge.missing = qToLittleEndian((qint32)counts[9]);
+         edge.clusterOutliers = qToLittleEndian((qint32)counts[8]);
+         edge.pairOutliers = qToLittleEndian((qint32)counts[7]);
+         edge.tooLow = qToLittleEndian((qint32)counts[6]);
+
+         memcpy(b, &edge, sizeof(BinaryEdge));
+
+         // copy the packed mask of the cluster if there is one, otherwise pack the mask
+         // built from missing expressions
+         if ( maskSize > 0 )
+         {
+            char* mask {b + sizeof(BinaryEdge)};
 
-            // determine sample mask from expression data
-            for ( int i = 0; i < _emx->getSampleSize(); ++i )
+            if ( window.clusterSize(i) > 1 )
             {
-               if ( isnan(gene1.at(i)) || isnan(gene2.at(i)) )
-               {
-                  sampleMask[i] = '9';
-               }
-               else
+               if ( window.clusterData(i) )
                {
-                  sampleMask[i] = '1';
+                  memcpy(mask, window.clusterData(i), maskSize);
                }
             }
+            else
+            {
+               TextIO::packMask(sampleMask.constData(), sampleMask.constData() + sampleSize, mask);
+            }
          }
 
-         // write edge to file
-         stream
-            << "    <edge"
-            << " source=\"" << source << "\""
-            << " target=\"" << target << "\""
-            << " samples=\"" << sampleMask << "\""
-            << "/>\n";
+         b += recordSize;
       }
-   }
 
-   // write footer to file
-   stream
-      << "  </graph>\n"
-      << "</graphml>\n";
+      // write edge to graphml text
+      if ( g )
+      {
+         g = append(g, EDGE_SOURCE);
+         g = append(g, source);
+         g = append(g, EDGE_TARGET);
+         g = append(g, target);
+         g = append(g, EDGE_SAMPLES);
+         g = append(g, sampleMask);
+         g = append(g, EDGE_END);
+      }
+   }
 
-   // make sure writing graphml file worked
-   if ( stream.status() != QTextStream::Ok )
+   if ( text )
    {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
-      throw e;
+      text->resize(p - text->data());
    }
-}
-
-
-
-
 
+   if ( graphml )
+   {
+      graphml->resize(g - graphml->data());
+   }
 
-EAbstractAnalytic::Input* Extract::makeInput()
-{
-   return new Input(this);
+   if ( binary )
+   {
+      binary->resize(b - binary->data());
+   }
 }
 
 
@@ -289,13 +552,14 @@ EAbstractAnalytic::Input* Extract::makeInput()
 
 
 
-void Extract::initialize()
+void Extract::write(QFile* file, const QByteArray& data)
 {
-   if ( !_emx || !_ccm || !_cmx || !_output )
+   // make sure writing output file worked
+   if ( file->write(data) != data.size() )
    {
       E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("Invalid Argument"));
-      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing to output file: %1").arg(file->errorString()));
       throw e;
    }
 }
@@ -5,6 +5,7 @@
 #include "ccmatrix.h"
 #include "correlationmatrix.h"
 #include "expressionmatrix.h"
+#include "pairwise_matrixwindow.h"
 
 
 
@@ -13,16 +14,59 @@ class Extract : public EAbstractAnalytic
    Q_OBJECT
 public:
    class Input;
+   // header of the binary edge list, which is followed by the gene name table at
+   // namesOffset and the edge records at edgesOffset, all in little-endian byte order
+   struct BinaryHeader
+   {
+      char magic[8];
+      quint32 version;
+      quint32 recordSize;
+      qint32 geneSize;
+      qint32 sampleSize;
+      qint32 maskSize;
+      qint32 reserved;
+      qint64 edgeSize;
+      qint64 namesOffset;
+      qint64 edgesOffset;
+      qint64 reserved2;
+   };
+   // fixed part of each edge record, which is followed by maskSize bytes of the sample
+   // mask packed two samples per byte and padded so records stay 4-byte aligned
+   struct BinaryEdge
+   {
+      qint32 source;
+      qint32 target;
+      float correlation;
+      qint8 cluster;
+      qint8 clusterSize;
+      qint16 reserved;
+      qint32 samples;
+      qint32 missing;
+      qint32 clusterOutliers;
+      qint32 pairOutliers;
+      qint32 tooLow;
+   };
+   static const char BINARY_MAGIC[8];
+   constexpr static quint32 BINARY_VERSION {1};
    virtual int size() const override final;
    virtual void process(const EAbstractAnalytic::Block* result) override final;
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
+   QVector<quint64> readMissing() const;
+   int binaryRecordSize() const;
+   QByteArray makeBinaryHeader(qint64 edgeSize, qint64 edgesOffset) const;
+   QByteArray makeBinaryNames(const QVector<QByteArray>& geneNames) const;
+   void formatEdges(const Pairwise::MatrixWindow& window, qint64 begin, int size, const QVector<QByteArray>& geneNames, const QVector<quint64>& missing, QByteArray* text, QByteArray* graphml, QByteArray* binary) const;
+   void write(QFile* file, const QByteArray& data);
    ExpressionMatrix* _emx {nullptr};
    CCMatrix* _ccm {nullptr};
    CorrelationMatrix* _cmx {nullptr};
    QFile* _output {nullptr};
    QFile* _graphml {nullptr};
+   QFile* _index {nullptr};
+   QFile* _binary {nullptr};
+   bool _binaryMasks {false};
    float _minCorrelation {0.85};
    float _maxCorrelation {1.00};
 };
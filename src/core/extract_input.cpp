@@ -41,6 +41,9 @@ EAbstractAnalytic::Input::Type Extract::Input::type(int index) const
    case GraphMLFile: return Type::FileOut;
    case MinCorrelation: return Type::Double;
    case MaxCorrelation: return Type::Double;
+   case IndexFile: return Type::FileIn;
+   case BinaryFile: return Type::FileOut;
+   case BinaryMasks: return Type::Boolean;
    default: return Type::Boolean;
    }
 }
@@ -86,7 +89,7 @@ QVariant Extract::Input::data(int index, Role role) const
       {
       case Role::CommandLineName: return QString("output");
       case Role::Title: return tr("Output File:");
-      case Role::WhatsThis: return tr("Output text file that will contain network edges.");
+      case Role::WhatsThis: return tr("Output text file that will contain network edges. Optional if a binary edge list is written.");
       case Role::FileFilters: return tr("Text file %1").arg("(*.txt)");
       default: return QVariant();
       }
@@ -121,6 +124,33 @@ QVariant Extract::Input::data(int index, Role role) const
       case Role::Maximum: return 1;
       default: return QVariant();
       }
+   case IndexFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("index");
+      case Role::Title: return tr("Threshold Index:");
+      case Role::WhatsThis: return tr("Optional threshold index of the correlation matrix, used to skip blocks without correlations within the thresholds.");
+      case Role::FileFilters: return tr("Threshold index file %1").arg("(*.index)");
+      default: return QVariant();
+      }
+   case BinaryFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("binary");
+      case Role::Title: return tr("Binary Edge List:");
+      case Role::WhatsThis: return tr("Output binary file that will contain network edges as fixed-size records along with a table of gene names.");
+      case Role::FileFilters: return tr("Binary edge list %1").arg("(*.edges)");
+      default: return QVariant();
+      }
+   case BinaryMasks:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("binary-masks");
+      case Role::Title: return tr("Binary Sample Masks:");
+      case Role::WhatsThis: return tr("Whether to include the packed sample mask of each edge in the binary edge list.");
+      case Role::Default: return false;
+      default: return QVariant();
+      }
    default: return QVariant();
    }
 }
@@ -140,6 +170,9 @@ void Extract::Input::set(int index, const QVariant& value)
    case MaxCorrelation:
       _base->_maxCorrelation = value.toFloat();
       break;
+   case BinaryMasks:
+      _base->_binaryMasks = value.toBool();
+      break;
    }
 }
 
@@ -179,4 +212,12 @@ void Extract::Input::set(int index, QFile* file)
    {
       _base->_graphml = file;
    }
+   else if ( index == IndexFile )
+   {
+      _base->_index = file;
+   }
+   else if ( index == BinaryFile )
+   {
+      _base->_binary = file;
+   }
 }
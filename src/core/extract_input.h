@@ -17,6 +17,9 @@ public:
       ,GraphMLFile
       ,MinCorrelation
       ,MaxCorrelation
+      ,IndexFile
+      ,BinaryFile
+      ,BinaryMasks
       ,Total
    };
    explicit Input(Extract* parent);
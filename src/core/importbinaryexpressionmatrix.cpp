@@ -0,0 +1,247 @@
+#include "importbinaryexpressionmatrix.h"
+#include "importbinaryexpressionmatrix_input.h"
+#include "datafactory.h"
+
+#include <QtEndian>
+
+
+
+
+
+
+int ImportBinaryExpressionMatrix::size() const
+{
+   return 1;
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::process(const EAbstractAnalytic::Block* result)
+{
+   Q_UNUSED(result);
+
+   // read gene and sample names
+   QStringList geneNames {readNames(_geneNames)};
+   QStringList sampleNames {readNames(_sampleNames)};
+
+   // map input file into memory
+   const qint64 fileSize {_input->size()};
+   uchar* map {fileSize > 0 ? _input->map(0, fileSize) : nullptr};
+   if ( !map )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Could not map input file into memory: %1").arg(_input->errorString()));
+      throw e;
+   }
+   const char* data {reinterpret_cast<const char*>(map)};
+
+   // determine layout of values from the header if this is a NumPy file, otherwise the
+   // file is raw float32 values with the shape given by the name lists
+   qint64 rows {geneNames.size()};
+   qint64 columns {sampleNames.size()};
+   ValueType type {ValueType::Float32};
+   qint64 offset {0};
+
+   if ( fileSize >= 6 && memcmp(data, "\x93NUMPY", 6) == 0 )
+   {
+      offset = readNumpyHeader(data, fileSize, &rows, &columns, &type);
+   }
+
+   // make sure the shape of the matrix matches the name lists
+   if ( rows != geneNames.size() || columns != sampleNames.size() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Matrix shape (%1, %2) does not match %3 gene names and %4 sample names.")
+                   .arg(rows).arg(columns).arg(geneNames.size()).arg(sampleNames.size()));
+      throw e;
+   }
+
+   // make sure the input file contains exactly the values of the matrix
+   const int valueSize {type == ValueType::Float32 ? 4 : 8};
+   if ( fileSize - offset != rows * columns * valueSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Input file contains %1 bytes of values when a %2 by %3 matrix needs %4.")
+                   .arg(fileSize - offset).arg(rows).arg(columns).arg(rows * columns * valueSize));
+      throw e;
+   }
+
+   // initialize expression matrix
+   _output->initialize(geneNames, sampleNames);
+
+   // copy genes to the expression matrix in windows of rows, converting and transforming
+   // each window in memory before it is written as one block
+   const int WINDOW_SIZE {1024};
+   QVector<Expression> expressions(WINDOW_SIZE * columns);
+
+   for ( int window = 0; window < rows; window += WINDOW_SIZE )
+   {
+      const int windowSize {(int)qMin((qint64)WINDOW_SIZE, rows - window)};
+      const qint64 size {windowSize * columns};
+
+      convertValues(data + offset + window * columns * valueSize, size, type, expressions.data());
+
+      ExpressionMatrix::applyTransform(_transform, expressions.data(), size);
+
+      _output->writeGenes(window, windowSize, expressions.constData());
+   }
+
+   _input->unmap(map);
+
+   // set transform used in expression matrix
+   _output->setTransform(_transform);
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input* ImportBinaryExpressionMatrix::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::initialize()
+{
+   if ( !_input || !_geneNames || !_sampleNames || !_output )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
+   }
+}
+
+
+
+
+
+
+QStringList ImportBinaryExpressionMatrix::readNames(QFile* file) const
+{
+   // read each non-empty line of the file as a name
+   QStringList names;
+   QTextStream stream(file);
+
+   while ( !stream.atEnd() )
+   {
+      QString line {stream.readLine().trimmed()};
+
+      if ( !line.isEmpty() )
+      {
+         names.append(line);
+      }
+   }
+
+   // make sure reading file worked
+   if ( stream.status() != QTextStream::Ok )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
+      throw e;
+   }
+
+   return names;
+}
+
+
+
+
+
+
+qint64 ImportBinaryExpressionMatrix::readNumpyHeader(const char* data, qint64 size, qint64* rows, qint64* columns, ValueType* type) const
+{
+   // read header length, which is 16 bits in version 1 and 32 bits in later versions
+   qint64 headerStart {0};
+   qint64 headerLength {0};
+
+   if ( size >= 10 && data[6] == 1 )
+   {
+      headerStart = 10;
+      headerLength = qFromLittleEndian<quint16>(data + 8);
+   }
+   else if ( size >= 12 && (data[6] == 2 || data[6] == 3) )
+   {
+      headerStart = 12;
+      headerLength = qFromLittleEndian<quint32>(data + 8);
+   }
+
+   if ( headerStart == 0 || headerStart + headerLength > size )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Parsing Error"));
+      e.setDetails(tr("NumPy file header is invalid or of an unsupported version."));
+      throw e;
+   }
+
+   // parse the header dictionary, which must describe a little-endian float32 or float64
+   // matrix in row-major order
+   QString header {QString::fromLatin1(data + headerStart, headerLength)};
+   QRegExp descr {"'descr'\\s*:\\s*'[<|]f([48])'"};
+   QRegExp fortranOrder {"'fortran_order'\\s*:\\s*False"};
+   QRegExp shape {"'shape'\\s*:\\s*\\(\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,?\\s*\\)"};
+
+   if ( descr.indexIn(header) == -1
+        || fortranOrder.indexIn(header) == -1
+        || shape.indexIn(header) == -1 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Parsing Error"));
+      e.setDetails(tr("NumPy file must contain a two-dimensional, row-major, little-endian "
+                      "float32 or float64 matrix, header is %1").arg(header.trimmed()));
+      throw e;
+   }
+
+   *type = (descr.cap(1) == "4") ? ValueType::Float32 : ValueType::Float64;
+   *rows = shape.cap(1).toLongLong();
+   *columns = shape.cap(2).toLongLong();
+
+   // return offset of the matrix values
+   return headerStart + headerLength;
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::convertValues(const char* data, qint64 size, ValueType type, Expression* expressions) const
+{
+   switch (type)
+   {
+   case ValueType::Float32:
+      // copy values as one block, swapping bytes only on big-endian hosts
+      memcpy(expressions, data, size * sizeof(float));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         quint32 word {qFromLittleEndian<quint32>(data + i * sizeof(float))};
+         memcpy(&expressions[i], &word, sizeof(float));
+      }
+#endif
+      break;
+   case ValueType::Float64:
+      // convert each value to float
+      for ( qint64 i = 0; i < size; ++i )
+      {
+         quint64 word {qFromLittleEndian<quint64>(data + i * sizeof(double))};
+         double value;
+         memcpy(&value, &word, sizeof(double));
+         expressions[i] = value;
+      }
+      break;
+   }
+}
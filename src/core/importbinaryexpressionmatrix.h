@@ -0,0 +1,38 @@
+#ifndef IMPORTBINARYEXPRESSIONMATRIX_H
+#define IMPORTBINARYEXPRESSIONMATRIX_H
+#include <ace/core/core.h>
+
+#include "expressionmatrix.h"
+
+
+
+class ImportBinaryExpressionMatrix : public EAbstractAnalytic
+{
+   Q_OBJECT
+public:
+   class Input;
+   virtual int size() const override final;
+   virtual void process(const EAbstractAnalytic::Block* result) override final;
+   virtual EAbstractAnalytic::Input* makeInput() override final;
+   virtual void initialize();
+private:
+   using Expression = ExpressionMatrix::Expression;
+   using Transform = ExpressionMatrix::Transform;
+   enum class ValueType
+   {
+      Float32
+      ,Float64
+   };
+   QStringList readNames(QFile* file) const;
+   qint64 readNumpyHeader(const char* data, qint64 size, qint64* rows, qint64* columns, ValueType* type) const;
+   void convertValues(const char* data, qint64 size, ValueType type, Expression* expressions) const;
+   QFile* _input {nullptr};
+   QFile* _geneNames {nullptr};
+   QFile* _sampleNames {nullptr};
+   ExpressionMatrix* _output {nullptr};
+   Transform _transform {Transform::None};
+};
+
+
+
+#endif
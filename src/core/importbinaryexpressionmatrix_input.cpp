@@ -0,0 +1,148 @@
+#include "importbinaryexpressionmatrix_input.h"
+#include "datafactory.h"
+
+
+
+
+
+
+ImportBinaryExpressionMatrix::Input::Input(ImportBinaryExpressionMatrix* parent):
+   EAbstractAnalytic::Input(parent),
+   _base(parent)
+{}
+
+
+
+
+
+
+int ImportBinaryExpressionMatrix::Input::size() const
+{
+   return Total;
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input::Type ImportBinaryExpressionMatrix::Input::type(int index) const
+{
+   switch (index)
+   {
+   case InputFile: return Type::FileIn;
+   case GeneNamesFile: return Type::FileIn;
+   case SampleNamesFile: return Type::FileIn;
+   case OutputData: return Type::DataOut;
+   case TransformType: return Type::Selection;
+   default: return Type::Boolean;
+   }
+}
+
+
+
+
+
+
+QVariant ImportBinaryExpressionMatrix::Input::data(int index, Role role) const
+{
+   switch (index)
+   {
+   case InputFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("input");
+      case Role::Title: return tr("Input:");
+      case Role::WhatsThis: return tr("Input NumPy file or raw little-endian float32 file containing a row-major matrix of gene expression data.");
+      case Role::FileFilters: return tr("NumPy file %1;;Raw file %2").arg("(*.npy)").arg("(*.bin *.raw)");
+      default: return QVariant();
+      }
+   case GeneNamesFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("genes");
+      case Role::Title: return tr("Gene Names:");
+      case Role::WhatsThis: return tr("Input text file containing one gene name per line in row order.");
+      case Role::FileFilters: return tr("Text file %1").arg("(*.txt)");
+      default: return QVariant();
+      }
+   case SampleNamesFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("samples");
+      case Role::Title: return tr("Sample Names:");
+      case Role::WhatsThis: return tr("Input text file containing one sample name per line in column order.");
+      case Role::FileFilters: return tr("Text file %1").arg("(*.txt)");
+      default: return QVariant();
+      }
+   case OutputData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("output");
+      case Role::Title: return tr("Output:");
+      case Role::WhatsThis: return tr("Output expression matrix that will contain expression data.");
+      case Role::DataType: return DataFactory::ExpressionMatrixType;
+      default: return QVariant();
+      }
+   case TransformType:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("transform");
+      case Role::Title: return tr("Transform:");
+      case Role::WhatsThis: return tr("Element-wise transformation to apply to expression data.");
+      case Role::Default: return ExpressionMatrix::TRANSFORM_NAMES.first();
+      case Role::SelectionValues: return ExpressionMatrix::TRANSFORM_NAMES;
+      default: return QVariant();
+      }
+   default: return QVariant();
+   }
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::Input::set(int index, const QVariant& value)
+{
+   switch (index)
+   {
+   case TransformType:
+      _base->_transform = static_cast<Transform>(ExpressionMatrix::TRANSFORM_NAMES.indexOf(value.toString()));
+      break;
+   }
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::Input::set(int index, QFile* file)
+{
+   switch (index)
+   {
+   case InputFile:
+      _base->_input = file;
+      break;
+   case GeneNamesFile:
+      _base->_geneNames = file;
+      break;
+   case SampleNamesFile:
+      _base->_sampleNames = file;
+      break;
+   }
+}
+
+
+
+
+
+
+void ImportBinaryExpressionMatrix::Input::set(int index, EAbstractData* data)
+{
+   if ( index == OutputData )
+   {
+      _base->_output = data->cast<ExpressionMatrix>();
+   }
+}
@@ -0,0 +1,33 @@
+#ifndef IMPORTBINARYEXPRESSIONMATRIX_INPUT_H
+#define IMPORTBINARYEXPRESSIONMATRIX_INPUT_H
+#include "importbinaryexpressionmatrix.h"
+
+
+
+class ImportBinaryExpressionMatrix::Input : public EAbstractAnalytic::Input
+{
+   Q_OBJECT
+public:
+   enum Argument
+   {
+      InputFile = 0
+      ,GeneNamesFile
+      ,SampleNamesFile
+      ,OutputData
+      ,TransformType
+      ,Total
+   };
+   explicit Input(ImportBinaryExpressionMatrix* parent);
+   virtual int size() const override final;
+   virtual EAbstractAnalytic::Input::Type type(int index) const override final;
+   virtual QVariant data(int index, Role role) const override final;
+   virtual void set(int index, const QVariant& value) override final;
+   virtual void set(int index, QFile* file) override final;
+   virtual void set(int index, EAbstractData* data) override final;
+private:
+   ImportBinaryExpressionMatrix* _base;
+};
+
+
+
+#endif
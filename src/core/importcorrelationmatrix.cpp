@@ -1,7 +1,9 @@
 #include "importcorrelationmatrix.h"
 #include "importcorrelationmatrix_input.h"
 #include "datafactory.h"
-#include "pairwise_index.h"
+#include "textio.h"
+
+#include <QtConcurrent>
 
 
 
@@ -45,111 +47,257 @@ void ImportCorrelationMatrix::process(const EAbstractAnalytic::Block* result)
    _ccm->initialize(metaGeneNames, _maxClusterSize, metaSampleNames);
    _cmx->initialize(metaGeneNames, _maxClusterSize, metaCorrelationNames);
 
-   Pairwise::Index index;
-   CCMatrix::Pair ccmPair(_ccm);
-   CorrelationMatrix::Pair cmxPair(_cmx);
+   _masks.resize(_maxClusterSize * ((_sampleSize + 1) / 2));
+   _correlations.resize(_maxClusterSize);
+
+   // map input file into memory if possible, otherwise read it in blocks
+   const qint64 fileSize {_input->size()};
+   uchar* map {fileSize > 0 ? _input->map(0, fileSize) : nullptr};
+   const char* data {reinterpret_cast<const char*>(map)};
+
+   // process the input in windows of whole lines so only one window of parsed lines is
+   // in memory at once
+   const qint64 WINDOW_SIZE {64 * 1024 * 1024};
+   qint64 position {0};
+   QByteArray buffer;
+   QByteArray window;
 
-   // create text stream from input file and read until end reached
-   QTextStream stream(_input);
-   while ( !stream.atEnd() )
+   while ( true )
    {
-      // read a line from text file
-      QString line = stream.readLine();
-      auto words = line.splitRef(QRegExp("\\s+"), QString::SkipEmptyParts);
+      const char* begin;
+      const char* end;
 
-      // make sure the line is valid
-      if ( words.size() == 11 )
+      if ( map )
       {
-         int geneX = words[0].toInt();
-         int geneY = words[1].toInt();
-         float correlation = words[9].toFloat();
-         QStringRef sampleMask = words[10];
+         if ( position == fileSize )
+         {
+            break;
+         }
 
-         // make sure sample mask has correct length
-         if ( sampleMask.size() != _sampleSize )
+         // extend the window to the end of its last line
+         begin = data + position;
+         end = TextIO::lineEnd(data + qMin(position + WINDOW_SIZE, fileSize), data + fileSize);
+         end = qMin(end + 1, data + fileSize);
+         position = end - data;
+      }
+      else
+      {
+         if ( _input->atEnd() && buffer.isEmpty() )
          {
-            E_MAKE_EXCEPTION(e);
-            e.setTitle(tr("Parsing Error"));
-            e.setDetails(tr("Encountered sample mask with invalid length %1. "
-                            "Sample size is %2.")
-                         .arg(sampleMask.size()).arg(_sampleSize));
-            throw e;
+            break;
          }
 
-         // save previous pair when new pair is read
-         Pairwise::Index nextIndex(geneX, geneY);
+         // read the next block and keep the partial line at its end for the next window
+         buffer.append(_input->read(WINDOW_SIZE));
 
-         if ( index != nextIndex )
+         int cut {_input->atEnd() ? buffer.size() : buffer.lastIndexOf('\n') + 1};
+         if ( cut == 0 )
          {
-            // save pairs
-            if ( ccmPair.clusterSize() > 1 )
-            {
-               ccmPair.write(index);
-            }
-
-            if ( cmxPair.clusterSize() > 0 )
-            {
-               cmxPair.write(index);
-            }
-
-            // reset pairs
-            ccmPair.clearClusters();
-            cmxPair.clearClusters();
-
-            // update index
-            index = nextIndex;
+            continue;
          }
 
-         // append data to ccm pair and cmx pair
-         int cluster = ccmPair.clusterSize();
+         window = buffer.left(cut);
+         buffer.remove(0, cut);
+         begin = window.constData();
+         end = begin + window.size();
+      }
 
-         ccmPair.addCluster();
-         cmxPair.addCluster();
+      processWindow(begin, end);
+   }
 
-         for ( int i = 0; i < sampleMask.size(); ++i )
-         {
-            ccmPair.at(cluster, i) = sampleMask[i].digitValue();
-         }
+   // save last pair
+   writePair();
 
-         cmxPair.at(cluster, 0) = correlation;
+   if ( map )
+   {
+      _input->unmap(map);
+   }
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input* ImportCorrelationMatrix::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void ImportCorrelationMatrix::initialize()
+{
+   if ( !_input || !_ccm || !_cmx )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
+   }
+
+   if ( _correlationName.isEmpty() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Correlation name is required."));
+      throw e;
+   }
+}
+
+
+
+
+
+
+void ImportCorrelationMatrix::processWindow(const char* begin, const char* end)
+{
+   // split window into chunks of whole lines
+   const qint64 CHUNK_SIZE {1024 * 1024};
+   QVector<Chunk> chunks;
+
+   for ( const char* p = begin; p < end; )
+   {
+      const char* chunkEnd {TextIO::lineEnd(p + qMin(CHUNK_SIZE, (qint64)(end - p)), end)};
+      chunkEnd = qMin(chunkEnd + 1, end);
+
+      Chunk chunk;
+      chunk.begin = p;
+      chunk.end = chunkEnd;
+      chunks.append(chunk);
+
+      p = chunkEnd;
+   }
+
+   // parse chunks in parallel, saving the error of any chunk so it can be thrown from
+   // this thread
+   QtConcurrent::blockingMap(chunks, [this](Chunk& chunk)
+   {
+      try
+      {
+         parseChunk(&chunk);
+      }
+      catch ( ... )
+      {
+         chunk.error = std::current_exception();
       }
+   });
 
-      // save last pair
-      if ( ccmPair.clusterSize() > 1 )
+   // write chunks in order
+   for ( auto& chunk : chunks )
+   {
+      if ( chunk.error )
       {
-         ccmPair.write(index);
+         std::rethrow_exception(chunk.error);
       }
 
-      if ( cmxPair.clusterSize() > 0 )
+      writeChunk(chunk);
+   }
+}
+
+
+
+
+
+
+void ImportCorrelationMatrix::parseChunk(Chunk* chunk) const
+{
+   const int FIELD_SIZE {11};
+   const int maskSize {(_sampleSize + 1) / 2};
+
+   for ( const char* line = chunk->begin; line < chunk->end; )
+   {
+      const char* lineEnd {TextIO::lineEnd(line, chunk->end)};
+
+      // split line into fields
+      const char* fields[FIELD_SIZE];
+      const char* fieldEnds[FIELD_SIZE];
+      int count {0};
+
+      for ( const char* p = TextIO::skipSpace(line, lineEnd); p != lineEnd; ++count )
       {
-         cmxPair.write(index);
+         const char* tokenEnd {TextIO::skipToken(p, lineEnd)};
+
+         if ( count < FIELD_SIZE )
+         {
+            fields[count] = p;
+            fieldEnds[count] = tokenEnd;
+         }
+
+         p = TextIO::skipSpace(tokenEnd, lineEnd);
       }
 
-      // skip empty lines and lines with '#' markers
-      else if ( words.size() != 1 && words.size() != 0 )
+      // make sure the line is valid
+      if ( count == FIELD_SIZE )
       {
-         continue;
+         qint32 geneX;
+         qint32 geneY;
+         float correlation;
+
+         if ( !TextIO::parseInt(fields[0], fieldEnds[0], &geneX)
+              || !TextIO::parseInt(fields[1], fieldEnds[1], &geneY)
+              || !TextIO::parseFloat(fields[9], fieldEnds[9], &correlation) )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Parsing Error"));
+            e.setDetails(tr("Failed to read gene indices or correlation of line \"%1\".")
+                         .arg(QString::fromUtf8(line, lineEnd - line).trimmed()));
+            throw e;
+         }
+
+         // make sure pair is valid
+         if ( geneY < 0 || geneX <= geneY || geneX >= _geneSize )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Parsing Error"));
+            e.setDetails(tr("Encountered invalid pair (%1, %2). Gene size is %3.")
+                         .arg(geneX).arg(geneY).arg(_geneSize));
+            throw e;
+         }
+
+         // make sure sample mask has correct length
+         if ( fieldEnds[10] - fields[10] != _sampleSize )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Parsing Error"));
+            e.setDetails(tr("Encountered sample mask with invalid length %1. "
+                            "Sample size is %2.")
+                         .arg(fieldEnds[10] - fields[10]).arg(_sampleSize));
+            throw e;
+         }
+
+         // convert sample mask straight into packed cluster matrix data
+         int maskIndex {chunk->masks.size()};
+         chunk->masks.resize(maskIndex + maskSize);
+
+         if ( !TextIO::packMask(fields[10], fieldEnds[10], chunk->masks.data() + maskIndex) )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Parsing Error"));
+            e.setDetails(tr("Encountered sample mask \"%1\" with non-digit values.")
+                         .arg(QString::fromUtf8(fields[10], fieldEnds[10] - fields[10])));
+            throw e;
+         }
+
+         chunk->indices.append(Pairwise::Index(geneX, geneY).pack());
+         chunk->correlations.append(correlation);
       }
 
-      // otherwise throw an error
-      else
+      // skip empty lines and lines with '#' markers, otherwise throw an error
+      else if ( count != 0 && *fields[0] != '#' )
       {
          E_MAKE_EXCEPTION(e);
          e.setTitle(tr("Parsing Error"));
          e.setDetails(tr("Encountered line with incorrect amount of fields. "
                          "Read %1 fields when there should have been %2.")
-                      .arg(words.size()).arg(11));
+                      .arg(count).arg(FIELD_SIZE));
          throw e;
       }
-   }
 
-   // make sure reading input file worked
-   if ( stream.status() != QTextStream::Ok )
-   {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
-      throw e;
+      line = lineEnd + 1;
    }
 }
 
@@ -158,9 +306,36 @@ void ImportCorrelationMatrix::process(const EAbstractAnalytic::Block* result)
 
 
 
-EAbstractAnalytic::Input* ImportCorrelationMatrix::makeInput()
+void ImportCorrelationMatrix::writeChunk(const Chunk& chunk)
 {
-   return new Input(this);
+   const int maskSize {(_sampleSize + 1) / 2};
+
+   for ( int i = 0; i < chunk.indices.size(); ++i )
+   {
+      // save previous pair when new pair is read
+      Pairwise::Index index {Pairwise::Index::unpack(chunk.indices.at(i))};
+
+      if ( index != _index )
+      {
+         writePair();
+         _index = index;
+      }
+
+      // make sure the pair does not have too many clusters
+      if ( _clusterSize == _maxClusterSize )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Parsing Error"));
+         e.setDetails(tr("Pair (%1, %2) has more than the max of %3 clusters.")
+                      .arg(index.getX()).arg(index.getY()).arg(_maxClusterSize));
+         throw e;
+      }
+
+      // append cluster to current pair
+      memcpy(_masks.data() + _clusterSize * maskSize, chunk.masks.constData() + i * maskSize, maskSize);
+      _correlations[_clusterSize] = chunk.correlations.at(i);
+      ++_clusterSize;
+   }
 }
 
 
@@ -168,21 +343,19 @@ EAbstractAnalytic::Input* ImportCorrelationMatrix::makeInput()
 
 
 
-void ImportCorrelationMatrix::initialize()
+void ImportCorrelationMatrix::writePair()
 {
-   if ( !_input || !_ccm || !_cmx )
+   // save pairs
+   if ( _clusterSize > 1 )
    {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("Invalid Argument"));
-      e.setDetails(tr("Did not get valid input and/or output arguments."));
-      throw e;
+      _ccm->writePair(_index, _clusterSize, _masks.constData());
    }
 
-   if ( _correlationName.isEmpty() )
+   if ( _clusterSize > 0 )
    {
-      E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("Invalid Argument"));
-      e.setDetails(tr("Correlation name is required."));
-      throw e;
+      _cmx->writePair(_index, _clusterSize, reinterpret_cast<const char*>(_correlations.constData()));
    }
+
+   // reset pair
+   _clusterSize = 0;
 }
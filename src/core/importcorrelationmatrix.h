@@ -4,6 +4,7 @@
 
 #include "ccmatrix.h"
 #include "correlationmatrix.h"
+#include "pairwise_index.h"
 
 
 
@@ -17,6 +18,19 @@ public:
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
+   struct Chunk
+   {
+      const char* begin;
+      const char* end;
+      QVector<Pairwise::PackedIndex> indices;
+      QVector<float> correlations;
+      QByteArray masks;
+      std::exception_ptr error;
+   };
+   void processWindow(const char* begin, const char* end);
+   void parseChunk(Chunk* chunk) const;
+   void writeChunk(const Chunk& chunk);
+   void writePair();
    QFile* _input {nullptr};
    CCMatrix* _ccm {nullptr};
    CorrelationMatrix* _cmx {nullptr};
@@ -24,6 +38,12 @@ private:
    qint32 _maxClusterSize {1};
    qint32 _sampleSize {0};
    QString _correlationName;
+   // clusters of the pair currently being read, which is written once a line of the next
+   // pair is read
+   Pairwise::Index _index;
+   int _clusterSize {0};
+   QByteArray _masks;
+   QVector<float> _correlations;
 };
 
 
@@ -1,6 +1,9 @@
 #include "importexpressionmatrix.h"
 #include "importexpressionmatrix_input.h"
 #include "datafactory.h"
+#include "textio.h"
+
+#include <QtConcurrent>
 
 
 
@@ -21,152 +24,280 @@ void ImportExpressionMatrix::process(const EAbstractAnalytic::Block* result)
 {
    Q_UNUSED(result);
 
-   // use expression declaration
-   using Expression = ExpressionMatrix::Expression;
+   // if sample size is not zero then build sample name list
+   QStringList sampleNames;
 
-   // structure for building list of genes
-   struct Gene
+   if ( _sampleSize != 0 )
    {
-      Gene(int size)
-      {
-         expressions = new Expression[size];
-      }
-      ~Gene()
+      for (int i = 0; i < _sampleSize ;++i)
       {
-         delete[] expressions;
+         sampleNames.append(QString::number(i));
       }
+   }
 
-      Expression* expressions;
-   };
+   // map input file into memory if possible, otherwise stream it
+   const qint64 fileSize {_input->size()};
+   uchar* data {fileSize > 0 ? _input->map(0, fileSize) : nullptr};
 
-   // initialize gene expression linked list
-   QList<Gene *> genes;
+   if ( data )
+   {
+      processMapped(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + fileSize, sampleNames);
+      _input->unmap(data);
+   }
+   else
+   {
+      processStream(sampleNames);
+   }
 
-   // initialize gene and sample name lists
-   QStringList geneNames;
-   QStringList sampleNames;
+   // set transform used in expression matrix
+   _output->setTransform(_transform);
+}
 
-   // if sample size is not zero then build sample name list
-   if ( _sampleSize != 0 )
+
+
+
+
+
+EAbstractAnalytic::Input* ImportExpressionMatrix::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void ImportExpressionMatrix::initialize()
+{
+   if ( !_input || !_output )
    {
-      for (int i = 0; i < _sampleSize ;++i)
-      {
-         sampleNames.append(QString::number(i));
-      }
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
    }
+}
+
+
+
 
-   // create text stream from input file and read until end reached
-   QTextStream stream(_input);
-   while ( !stream.atEnd() )
+
+
+void ImportExpressionMatrix::processMapped(const char* data, const char* end, QStringList sampleNames)
+{
+   // find the beginning of every non-empty line, reading sample names from the first line
+   // if there is a header and gene names from the first word of every other line
+   QStringList geneNames;
+   QVector<const char*> lines;
+   for ( const char* line = data; line < end; )
    {
-      // read a line from text file
-      QString line = stream.readLine();
-      auto words = line.splitRef(QRegExp("\\s+"), QString::SkipEmptyParts);
+      const char* lineEnd {TextIO::lineEnd(line, end)};
 
-      // read sample names from first line
-      if ( _sampleSize == 0 )
+      if ( TextIO::skipSpace(line, lineEnd) != lineEnd )
       {
-         _sampleSize = words.size();
-         for ( auto& word : words )
+         if ( _sampleSize == 0 )
+         {
+            sampleNames = splitNames(line, lineEnd);
+            _sampleSize = sampleNames.size();
+         }
+         else
          {
-            sampleNames.append(word.toString());
+            geneNames.append(readGeneName(line, lineEnd));
+            lines.append(line);
          }
       }
 
-      // make sure the number of words matches expected sample size
-      else if ( words.size() == _sampleSize + 1 )
+      line = lineEnd + 1;
+   }
+
+   // initialize expression matrix
+   _output->initialize(geneNames, sampleNames, _storage);
+
+   // parse lines in windows of parallel chunks so only one window of expressions is in
+   // memory at once, saving the error of any chunk so it can be thrown from this thread
+   const int CHUNK_SIZE {64};
+   const int WINDOW_SIZE {16 * CHUNK_SIZE};
+   QVector<Expression> expressions(WINDOW_SIZE * _sampleSize);
+   QByteArray noSampleToken {_noSampleToken.toUtf8()};
+
+   for ( int window = 0; window < lines.size(); window += WINDOW_SIZE )
+   {
+      const int windowSize {qMin(WINDOW_SIZE, lines.size() - window)};
+
+      QVector<int> chunks;
+      for ( int i = 0; i < windowSize; i += CHUNK_SIZE )
       {
-         // read row from text file into gene
-         Gene* gene {new Gene(_sampleSize)};
+         chunks.append(i);
+      }
+      QVector<std::exception_ptr> errors(chunks.size());
 
-         for ( int i = 1; i < words.size(); ++i )
+      QtConcurrent::blockingMap(chunks, [&](int& first)
+      {
+         try
          {
-            // if word matches no sample token string set it as such
-            if ( words.at(i) == _noSampleToken )
+            int last {qMin(first + CHUNK_SIZE, windowSize)};
+            for ( int i = first; i < last; ++i )
             {
-               gene->expressions[i-1] = NAN;
+               const char* line {lines[window + i]};
+               parseGene(line, TextIO::lineEnd(line, end), noSampleToken,
+                         &expressions[i * _sampleSize]);
             }
+         }
+         catch ( ... )
+         {
+            errors[first / CHUNK_SIZE] = std::current_exception();
+         }
+      });
 
-            // else this is a normal floating point expression
-            else
-            {
-               // read in the floating point value
-               bool ok;
-               Expression value = words.at(i).toDouble(&ok);
-
-               // make sure reading worked
-               if ( !ok )
-               {
-                  E_MAKE_EXCEPTION(e);
-                  e.setTitle(tr("Parsing Error"));
-                  e.setDetails(tr("Failed to read expression value \"%1\" for gene %2.")
-                               .arg(words.at(i).toString()).arg(words.at(0).toString()));
-                  throw e;
-               }
-
-               // apply transform and append expression to gene
-               switch (_transform)
-               {
-               case Transform::None:
-                  gene->expressions[i-1] = value;
-                  break;
-               case Transform::NLog:
-                  gene->expressions[i-1] = log(value);
-                  break;
-               case Transform::Log2:
-                  gene->expressions[i-1] = log2(value);
-                  break;
-               case Transform::Log10:
-                  gene->expressions[i-1] = log10(value);
-                  break;
-               }
-            }
+      for ( auto& error : errors )
+      {
+         if ( error )
+         {
+            std::rethrow_exception(error);
          }
+      }
+
+      // write window of genes to expression matrix
+      _output->writeGenes(window, windowSize, expressions.constData());
+   }
+}
+
+
+
 
-         // append gene data and gene name
-         genes.append(gene);
-         geneNames.append(words.at(0).toString());
+
+
+void ImportExpressionMatrix::processStream(QStringList sampleNames)
+{
+   QByteArray line;
+
+   // read sample names from header line if there is one
+   if ( _sampleSize == 0 && readLine(&line) )
+   {
+      sampleNames = splitNames(line.constData(), line.constData() + line.size());
+      _sampleSize = sampleNames.size();
+   }
+
+   // build gene name list, either from a counting pass over the input which is then read
+   // again or from the given gene size in which case names are read during the one pass
+   QStringList geneNames;
+
+   if ( _geneSize == 0 )
+   {
+      if ( _input->isSequential() )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("File IO Error"));
+         e.setDetails(tr("Input file cannot be mapped or read twice, the number of genes must be given."));
+         throw e;
+      }
+
+      const qint64 start {_input->pos()};
+      while ( readLine(&line) )
+      {
+         geneNames.append(readGeneName(line.constData(), line.constData() + line.size()));
+      }
+      _input->seek(start);
+   }
+   else
+   {
+      for ( int i = 0; i < _geneSize; ++i )
+      {
+         geneNames.append(QString::number(i));
       }
+   }
+
+   // initialize expression matrix
+   _output->initialize(geneNames, sampleNames, _storage);
 
-      // otherwise throw an error
-      else
+   // parse each line and write it straight to the expression matrix
+   QVector<Expression> expressions(_sampleSize);
+   QByteArray noSampleToken {_noSampleToken.toUtf8()};
+   int index {0};
+
+   while ( readLine(&line) )
+   {
+      // make sure there are not more genes than expected
+      if ( index >= geneNames.size() )
       {
          E_MAKE_EXCEPTION(e);
          e.setTitle(tr("Parsing Error"));
-         e.setDetails(tr("Encountered gene expression line with incorrect amount of fields. "
-                         "Read in %1 fields when it should have been %2. Gene name is %3.")
-                      .arg(words.size()-1).arg(_sampleSize).arg(words.at(0).toString()));
+         e.setDetails(tr("Input file contains more than the %1 genes expected.").arg(geneNames.size()));
          throw e;
       }
+
+      const char* end {line.constData() + line.size()};
+      parseGene(line.constData(), end, noSampleToken, expressions.data());
+      _output->writeGenes(index, 1, expressions.constData());
+
+      if ( _geneSize != 0 )
+      {
+         geneNames[index] = readGeneName(line.constData(), end);
+      }
+
+      ++index;
    }
 
-   // make sure reading input file worked
-   if ( stream.status() != QTextStream::Ok )
+   // make sure there are not fewer genes than expected
+   if ( index != geneNames.size() )
    {
       E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("File IO Error"));
-      e.setDetails(tr("Qt Text Stream encountered an unknown error."));
+      e.setTitle(tr("Parsing Error"));
+      e.setDetails(tr("Input file contains %1 genes when %2 were expected.").arg(index).arg(geneNames.size()));
       throw e;
    }
 
-   // initialize expression matrix
-   _output->initialize(geneNames, sampleNames);
+   // save gene names which were read during the pass
+   if ( _geneSize != 0 )
+   {
+      _output->initialize(geneNames, sampleNames, _storage);
+   }
+}
+
 
-   // iterate through each gene
-   ExpressionMatrix::Gene gene(_output);
-   for ( int i = 0; i < _output->getGeneSize(); ++i )
+
+
+
+
+bool ImportExpressionMatrix::readLine(QByteArray* line)
+{
+   // read lines until one that is not empty is found or the end is reached
+   while ( !_input->atEnd() )
    {
-      // save each gene to expression matrix
-      for ( int j = 0; j < _output->getSampleSize(); ++j )
+      *line = _input->readLine();
+
+      if ( TextIO::skipSpace(line->constData(), line->constData() + line->size()) != line->constData() + line->size() )
       {
-         gene[j] = genes[i]->expressions[j];
+         // remove newline so the line ends at its last word
+         if ( line->endsWith('\n') )
+         {
+            line->chop(1);
+         }
+         return true;
       }
+   }
+
+   return false;
+}
+
+
+
+
 
-      gene.write(i);
+
+QStringList ImportExpressionMatrix::splitNames(const char* begin, const char* end)
+{
+   QStringList names;
+
+   for ( const char* p = TextIO::skipSpace(begin, end); p != end; )
+   {
+      const char* tokenEnd {TextIO::skipToken(p, end)};
+      names.append(QString::fromUtf8(p, tokenEnd - p));
+      p = TextIO::skipSpace(tokenEnd, end);
    }
 
-   // set transform used in expression matrix
-   _output->setTransform(_transform);
+   return names;
 }
 
 
@@ -174,9 +305,11 @@ void ImportExpressionMatrix::process(const EAbstractAnalytic::Block* result)
 
 
 
-EAbstractAnalytic::Input* ImportExpressionMatrix::makeInput()
+QString ImportExpressionMatrix::readGeneName(const char* begin, const char* end)
 {
-   return new Input(this);
+   const char* p {TextIO::skipSpace(begin, end)};
+
+   return QString::fromUtf8(p, TextIO::skipToken(p, end) - p);
 }
 
 
@@ -184,13 +317,58 @@ EAbstractAnalytic::Input* ImportExpressionMatrix::makeInput()
 
 
 
-void ImportExpressionMatrix::initialize()
+void ImportExpressionMatrix::parseGene(const char* begin, const char* end, const QByteArray& noSampleToken, Expression* expressions) const
 {
-   if ( !_input || !_output )
+   // skip gene name
+   const char* nameBegin {TextIO::skipSpace(begin, end)};
+   const char* nameEnd {TextIO::skipToken(nameBegin, end)};
+
+   // read each word of the line as an expression
+   int count {0};
+   for ( const char* p = TextIO::skipSpace(nameEnd, end); p != end; ++count )
+   {
+      const char* tokenEnd {TextIO::skipToken(p, end)};
+
+      if ( count < _sampleSize )
+      {
+         // if word matches no sample token string set it as such
+         if ( tokenEnd - p == noSampleToken.size()
+              && memcmp(p, noSampleToken.constData(), noSampleToken.size()) == 0 )
+         {
+            expressions[count] = NAN;
+         }
+
+         // else this is a normal floating point expression
+         else
+         {
+            // read in the floating point value making sure reading worked
+            if ( !TextIO::parseFloat(p, tokenEnd, &expressions[count]) )
+            {
+               E_MAKE_EXCEPTION(e);
+               e.setTitle(tr("Parsing Error"));
+               e.setDetails(tr("Failed to read expression value \"%1\" for gene %2.")
+                            .arg(QString::fromUtf8(p, tokenEnd - p))
+                            .arg(QString::fromUtf8(nameBegin, nameEnd - nameBegin)));
+               throw e;
+            }
+         }
+      }
+
+      p = TextIO::skipSpace(tokenEnd, end);
+   }
+
+   // make sure the number of words matches expected sample size
+   if ( count != _sampleSize )
    {
       E_MAKE_EXCEPTION(e);
-      e.setTitle(tr("Invalid Argument"));
-      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      e.setTitle(tr("Parsing Error"));
+      e.setDetails(tr("Encountered gene expression line with incorrect amount of fields. "
+                      "Read in %1 fields when it should have been %2. Gene name is %3.")
+                   .arg(count).arg(_sampleSize)
+                   .arg(QString::fromUtf8(nameBegin, nameEnd - nameBegin)));
       throw e;
    }
+
+   // apply transform to the whole gene as a separate pass
+   ExpressionMatrix::applyTransform(_transform, expressions, _sampleSize);
 }
@@ -16,12 +16,22 @@ public:
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
+   using Expression = ExpressionMatrix::Expression;
    using Transform = ExpressionMatrix::Transform;
+   using Storage = ExpressionMatrix::Storage;
+   void processMapped(const char* data, const char* end, QStringList sampleNames);
+   void processStream(QStringList sampleNames);
+   bool readLine(QByteArray* line);
+   static QStringList splitNames(const char* begin, const char* end);
+   static QString readGeneName(const char* begin, const char* end);
+   void parseGene(const char* begin, const char* end, const QByteArray& noSampleToken, Expression* expressions) const;
    QFile* _input {nullptr};
    ExpressionMatrix* _output {nullptr};
    QString _noSampleToken;
    qint32 _sampleSize {0};
+   qint32 _geneSize {0};
    Transform _transform {Transform::None};
+   Storage _storage {Storage::Float32};
 };
 
 
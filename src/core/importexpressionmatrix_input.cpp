@@ -34,7 +34,9 @@ EAbstractAnalytic::Input::Type ImportExpressionMatrix::Input::type(int index) co
    case OutputData: return Type::DataOut;
    case NoSampleToken: return Type::String;
    case SampleSize: return Type::Integer;
+   case GeneSize: return Type::Integer;
    case TransformType: return Type::Selection;
+   case StorageType: return Type::Selection;
    default: return Type::Boolean;
    }
 }
@@ -85,6 +87,17 @@ QVariant ImportExpressionMatrix::Input::data(int index, Role role) const
       case Role::Maximum: return std::numeric_limits<int>::max();
       default: return QVariant();
       }
+   case GeneSize:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("genes");
+      case Role::Title: return tr("Gene Size:");
+      case Role::WhatsThis: return tr("Number of genes. 0 indicates the text file is read twice to determine size if it cannot be memory mapped.");
+      case Role::Default: return 0;
+      case Role::Minimum: return 0;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
    case TransformType:
       switch (role)
       {
@@ -95,6 +108,16 @@ QVariant ImportExpressionMatrix::Input::data(int index, Role role) const
       case Role::SelectionValues: return ExpressionMatrix::TRANSFORM_NAMES;
       default: return QVariant();
       }
+   case StorageType:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("storage");
+      case Role::Title: return tr("Storage:");
+      case Role::WhatsThis: return tr("Precision in which expressions are stored. float16 halves the size of the matrix and keeps missing values, but only holds magnitudes up to 65504 with about three significant digits.");
+      case Role::Default: return ExpressionMatrix::STORAGE_NAMES.first();
+      case Role::SelectionValues: return ExpressionMatrix::STORAGE_NAMES;
+      default: return QVariant();
+      }
    default: return QVariant();
    }
 }
@@ -111,12 +134,18 @@ void ImportExpressionMatrix::Input::set(int index, const QVariant& value)
    case SampleSize:
       _base->_sampleSize = value.toInt();
       break;
+   case GeneSize:
+      _base->_geneSize = value.toInt();
+      break;
    case NoSampleToken:
       _base->_noSampleToken = value.toString();
       break;
    case TransformType:
       _base->_transform = static_cast<Transform>(ExpressionMatrix::TRANSFORM_NAMES.indexOf(value.toString()));
       break;
+   case StorageType:
+      _base->_storage = static_cast<Storage>(ExpressionMatrix::STORAGE_NAMES.indexOf(value.toString()));
+      break;
    }
 }
 
@@ -14,7 +14,9 @@ public:
       ,OutputData
       ,NoSampleToken
       ,SampleSize
+      ,GeneSize
       ,TransformType
+      ,StorageType
       ,Total
    };
    explicit Input(ImportExpressionMatrix* parent);
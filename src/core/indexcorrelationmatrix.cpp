@@ -0,0 +1,57 @@
+#include "indexcorrelationmatrix.h"
+#include "indexcorrelationmatrix_input.h"
+#include "correlationmatrix_thresholdindex.h"
+#include "datafactory.h"
+
+
+
+
+
+
+int IndexCorrelationMatrix::size() const
+{
+   return 1;
+}
+
+
+
+
+
+
+void IndexCorrelationMatrix::process(const EAbstractAnalytic::Block* result)
+{
+   Q_UNUSED(result);
+
+   // build threshold index of correlation matrix and write it to output file
+   CorrelationMatrix::ThresholdIndex index(_input);
+   index.build(_blockSize);
+   index.save(_output);
+
+   qInfo("blocks: %d", index.blocks().size());
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input* IndexCorrelationMatrix::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void IndexCorrelationMatrix::initialize()
+{
+   if ( !_input || !_output )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
+   }
+}
@@ -0,0 +1,26 @@
+#ifndef INDEXCORRELATIONMATRIX_H
+#define INDEXCORRELATIONMATRIX_H
+#include <ace/core/core.h>
+
+#include "correlationmatrix.h"
+
+
+
+class IndexCorrelationMatrix : public EAbstractAnalytic
+{
+   Q_OBJECT
+public:
+   class Input;
+   virtual int size() const override final;
+   virtual void process(const EAbstractAnalytic::Block* result) override final;
+   virtual EAbstractAnalytic::Input* makeInput() override final;
+   virtual void initialize();
+private:
+   CorrelationMatrix* _input {nullptr};
+   QFile* _output {nullptr};
+   int _blockSize {65536};
+};
+
+
+
+#endif
@@ -0,0 +1,122 @@
+#include "indexcorrelationmatrix_input.h"
+#include "datafactory.h"
+#include "pairwise_index.h"
+
+
+
+
+
+
+IndexCorrelationMatrix::Input::Input(IndexCorrelationMatrix* parent):
+   EAbstractAnalytic::Input(parent),
+   _base(parent)
+{}
+
+
+
+
+
+
+int IndexCorrelationMatrix::Input::size() const
+{
+   return Total;
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input::Type IndexCorrelationMatrix::Input::type(int index) const
+{
+   switch (index)
+   {
+   case InputData: return Type::DataIn;
+   case OutputFile: return Type::FileOut;
+   case BlockSize: return Type::Integer;
+   default: return Type::Boolean;
+   }
+}
+
+
+
+
+
+
+QVariant IndexCorrelationMatrix::Input::data(int index, Role role) const
+{
+   switch (index)
+   {
+   case InputData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("cmx");
+      case Role::Title: return tr("Correlation Matrix:");
+      case Role::WhatsThis: return tr("Input correlation matrix to index.");
+      case Role::DataType: return DataFactory::CorrelationMatrixType;
+      default: return QVariant();
+      }
+   case OutputFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("output");
+      case Role::Title: return tr("Output:");
+      case Role::WhatsThis: return tr("Output threshold index file for the correlation matrix.");
+      case Role::FileFilters: return tr("Threshold index file %1").arg("(*.index)");
+      default: return QVariant();
+      }
+   case BlockSize:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("block-size");
+      case Role::Title: return tr("Block Size:");
+      case Role::WhatsThis: return tr("Number of clusters in each block of the index. Smaller blocks can be skipped more precisely but make a larger index.");
+      case Role::Default: return 65536;
+      case Role::Minimum: return Pairwise::Index::MAX_CLUSTER_SIZE + 1;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
+   default: return QVariant();
+   }
+}
+
+
+
+
+
+
+void IndexCorrelationMatrix::Input::set(int index, const QVariant& value)
+{
+   switch (index)
+   {
+   case BlockSize:
+      _base->_blockSize = value.toInt();
+      break;
+   }
+}
+
+
+
+
+
+
+void IndexCorrelationMatrix::Input::set(int index, QFile* file)
+{
+   if ( index == OutputFile )
+   {
+      _base->_output = file;
+   }
+}
+
+
+
+
+
+
+void IndexCorrelationMatrix::Input::set(int index, EAbstractData* data)
+{
+   if ( index == InputData )
+   {
+      _base->_input = data->cast<CorrelationMatrix>();
+   }
+}
@@ -0,0 +1,31 @@
+#ifndef INDEXCORRELATIONMATRIX_INPUT_H
+#define INDEXCORRELATIONMATRIX_INPUT_H
+#include "indexcorrelationmatrix.h"
+
+
+
+class IndexCorrelationMatrix::Input : public EAbstractAnalytic::Input
+{
+   Q_OBJECT
+public:
+   enum Argument
+   {
+      InputData = 0
+      ,OutputFile
+      ,BlockSize
+      ,Total
+   };
+   explicit Input(IndexCorrelationMatrix* parent);
+   virtual int size() const override final;
+   virtual EAbstractAnalytic::Input::Type type(int index) const override final;
+   virtual QVariant data(int index, Role role) const override final;
+   virtual void set(int index, const QVariant& value) override final;
+   virtual void set(int index, QFile* file) override final;
+   virtual void set(int index, EAbstractData* data) override final;
+private:
+   IndexCorrelationMatrix* _base;
+};
+
+
+
+#endif
@@ -0,0 +1,107 @@
+#include "mergesimilarity.h"
+#include "mergesimilarity_input.h"
+#include <ace/core/ace_dataobject.h>
+
+
+
+int MergeSimilarity::size() const
+{
+   return 1;
+}
+
+
+
+
+
+
+void MergeSimilarity::process(const EAbstractAnalytic::Block* result)
+{
+   Q_UNUSED(result);
+
+   // append each cluster matrix shard in order, the output takes its metadata from the
+   // first shard and appending fails if a shard does not match it or is out of order
+   for ( int i = 0; i < _ccmShards.size(); ++i )
+   {
+      Ace::DataObject shard(_ccmShards.at(i).trimmed());
+      const CCMatrix* ccm {shard.data()->cast<CCMatrix>()};
+
+      if ( i == 0 )
+      {
+         _ccm->initialize(ccm->geneNames(), ccm->maxClusterSize(), ccm->sampleNames());
+      }
+
+      // make sure shard has the same genes as the first shard, since appending also
+      // accepts matrices over fewer genes
+      if ( ccm->geneSize() != _ccm->geneSize() || ccm->maxClusterSize() != _ccm->maxClusterSize() )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Invalid Argument"));
+         e.setDetails(tr("Shard %1 does not have the same genes and clusters as the first shard.")
+                      .arg(_ccmShards.at(i)));
+         throw e;
+      }
+
+      _ccm->append(ccm);
+   }
+
+   // append each correlation matrix shard in order
+   for ( int i = 0; i < _cmxShards.size(); ++i )
+   {
+      Ace::DataObject shard(_cmxShards.at(i).trimmed());
+      const CorrelationMatrix* cmx {shard.data()->cast<CorrelationMatrix>()};
+
+      if ( i == 0 )
+      {
+         _cmx->initialize(cmx->geneNames(), cmx->maxClusterSize(), cmx->correlationNames());
+      }
+
+      // make sure shard has the same genes as the first shard, since appending also
+      // accepts matrices over fewer genes
+      if ( cmx->geneSize() != _cmx->geneSize() || cmx->maxClusterSize() != _cmx->maxClusterSize() )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Invalid Argument"));
+         e.setDetails(tr("Shard %1 does not have the same genes and clusters as the first shard.")
+                      .arg(_cmxShards.at(i)));
+         throw e;
+      }
+
+      _cmx->append(cmx);
+   }
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input* MergeSimilarity::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void MergeSimilarity::initialize()
+{
+   // make sure input and output arguments were given
+   if ( _ccmShards.isEmpty() || _cmxShards.isEmpty() || !_ccm || !_cmx )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
+   }
+
+   // make sure there is a cluster matrix shard for every correlation matrix shard
+   if ( _ccmShards.size() != _cmxShards.size() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Number of cluster matrix shards does not match number of correlation matrix shards."));
+      throw e;
+   }
+}
@@ -0,0 +1,28 @@
+#ifndef MERGESIMILARITY_H
+#define MERGESIMILARITY_H
+#include <ace/core/core.h>
+
+#include "ccmatrix.h"
+#include "correlationmatrix.h"
+
+
+
+class MergeSimilarity : public EAbstractAnalytic
+{
+   Q_OBJECT
+public:
+   class Input;
+   virtual int size() const override final;
+   virtual void process(const EAbstractAnalytic::Block* result) override final;
+   virtual EAbstractAnalytic::Input* makeInput() override final;
+   virtual void initialize();
+private:
+   QStringList _ccmShards;
+   QStringList _cmxShards;
+   CCMatrix* _ccm {nullptr};
+   CorrelationMatrix* _cmx {nullptr};
+};
+
+
+
+#endif
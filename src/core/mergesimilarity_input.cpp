@@ -0,0 +1,129 @@
+#include "mergesimilarity_input.h"
+#include "datafactory.h"
+
+
+
+MergeSimilarity::Input::Input(MergeSimilarity* parent):
+   EAbstractAnalytic::Input(parent),
+   _base(parent)
+{}
+
+
+
+
+
+
+int MergeSimilarity::Input::size() const
+{
+   return Total;
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input::Type MergeSimilarity::Input::type(int index) const
+{
+   switch (index)
+   {
+   case ClusterShards: return Type::String;
+   case CorrelationShards: return Type::String;
+   case ClusterData: return Type::DataOut;
+   case CorrelationData: return Type::DataOut;
+   default: return Type::Boolean;
+   }
+}
+
+
+
+
+
+
+QVariant MergeSimilarity::Input::data(int index, Role role) const
+{
+   switch (index)
+   {
+   case ClusterShards:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("ccm-shards");
+      case Role::Title: return tr("Cluster Matrix Shards:");
+      case Role::WhatsThis: return tr("Comma-separated list of cluster matrix shards in shard order.");
+      default: return QVariant();
+      }
+   case CorrelationShards:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("cmx-shards");
+      case Role::Title: return tr("Correlation Matrix Shards:");
+      case Role::WhatsThis: return tr("Comma-separated list of correlation matrix shards in shard order.");
+      default: return QVariant();
+      }
+   case ClusterData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("ccm");
+      case Role::Title: return tr("Cluster Matrix:");
+      case Role::WhatsThis: return tr("Output matrix that will contain pairwise clusters of all shards.");
+      case Role::DataType: return DataFactory::CCMatrixType;
+      default: return QVariant();
+      }
+   case CorrelationData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("cmx");
+      case Role::Title: return tr("Correlation Matrix:");
+      case Role::WhatsThis: return tr("Output matrix that will contain pairwise correlations of all shards.");
+      case Role::DataType: return DataFactory::CorrelationMatrixType;
+      default: return QVariant();
+      }
+   default: return QVariant();
+   }
+}
+
+
+
+
+
+
+void MergeSimilarity::Input::set(int index, const QVariant& value)
+{
+   switch (index)
+   {
+   case ClusterShards:
+      _base->_ccmShards = value.toString().split(',', QString::SkipEmptyParts);
+      break;
+   case CorrelationShards:
+      _base->_cmxShards = value.toString().split(',', QString::SkipEmptyParts);
+      break;
+   }
+}
+
+
+
+
+
+
+void MergeSimilarity::Input::set(int index, EAbstractData* data)
+{
+   if ( index == ClusterData )
+   {
+      _base->_ccm = data->cast<CCMatrix>();
+   }
+   else if ( index == CorrelationData )
+   {
+      _base->_cmx = data->cast<CorrelationMatrix>();
+   }
+}
+
+
+
+
+
+
+void MergeSimilarity::Input::set(int index, QFile* file)
+{
+   Q_UNUSED(index);
+   Q_UNUSED(file);
+}
@@ -0,0 +1,32 @@
+#ifndef MERGESIMILARITY_INPUT_H
+#define MERGESIMILARITY_INPUT_H
+#include "mergesimilarity.h"
+
+
+
+class MergeSimilarity::Input : public EAbstractAnalytic::Input
+{
+   Q_OBJECT
+public:
+   enum Argument
+   {
+      ClusterShards = 0
+      ,CorrelationShards
+      ,ClusterData
+      ,CorrelationData
+      ,Total
+   };
+   explicit Input(MergeSimilarity* parent);
+   virtual int size() const override final;
+   virtual EAbstractAnalytic::Input::Type type(int index) const override final;
+   virtual QVariant data(int index, Role role) const override final;
+   virtual void set(int index, const QVariant& value) override final;
+   virtual void set(int index, EAbstractData* data) override final;
+   virtual void set(int index, QFile* file) override final;
+private:
+   MergeSimilarity* _base;
+};
+
+
+
+#endif
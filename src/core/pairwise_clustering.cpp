@@ -31,6 +31,8 @@ qint8 Clustering::compute(
    bool removePreOutliers,
    bool removePostOutliers)
 {
+   _iterations = 0;
+
    // remove pre-clustering outliers
    if ( removePreOutliers )
    {
@@ -30,12 +30,16 @@ namespace Pairwise
          bool removePreOutliers,
          bool removePostOutliers
       );
+      int iterations() const { return _iterations; }
 
    protected:
       virtual bool fit(const QVector<Vector2>& X, int N, int K, QVector<qint8>& labels) = 0;
       virtual float logLikelihood() const = 0;
       virtual float entropy() const = 0;
 
+      // number of iterations of every fit in the last call to compute()
+      int _iterations {0};
+
    private:
       void markOutliers(const QVector<Vector2>& X, int N, int j, QVector<qint8>& labels, qint8 cluster, qint8 marker);
       float computeBIC(int K, float logL, int N, int D);
@@ -402,6 +402,8 @@ bool GMM::fit(const QVector<Vector2>& X, int N, int K, QVector<qint8>& labels)
    {
       for ( int t = 0; t < MAX_ITERATIONS; ++t )
       {
+         ++_iterations;
+
          // E step
          // compute gamma, log-likelihood
          calcLogMvNorm(X, N, loggamma);
@@ -6,6 +6,12 @@
 
 namespace Pairwise
 {
+   // pairwise index packed into 64 bits with gene x in the upper half and gene y in the
+   // lower half, so packed values sort in the same order as indexes
+   using PackedIndex = qint64;
+
+
+
    class Index
    {
    public:
@@ -14,7 +20,15 @@ namespace Pairwise
       Index(qint64 index);
       Index(const Index&) = default;
       Index(Index&&) = default;
+      static Index unpack(PackedIndex packed)
+         { return Index((qint32)(packed >> 32), (qint32)(packed & 0xFFFFFFFF)); }
+      static constexpr qint64 makeIndent(qint32 x, qint32 y, qint8 cluster)
+         { return ((qint64)x * (x - 1) / 2 + y) * MAX_CLUSTER_SIZE + cluster; }
       qint64 indent(qint8 cluster) const;
+      constexpr qint64 uncheckedIndent(qint8 cluster) const
+         { return makeIndent(_x, _y, cluster); }
+      constexpr PackedIndex pack() const
+         { return ((PackedIndex)_x << 32) | (quint32)_y; }
       qint32 getX() const { return _x; }
       qint32 getY() const { return _y; }
       Index& operator=(const Index&) = default;
@@ -23,15 +37,15 @@ namespace Pairwise
       Index operator++(int);
       bool operator==(const Index& object) const
          { return _x == object._x && _y == object._y; }
-      bool operator!=(const Index& object)
+      bool operator!=(const Index& object) const
          { return !(*this == object); }
-      bool operator<(const Index& object)
+      bool operator<(const Index& object) const
          { return _x < object._x || (_x == object._x && _y < object._y); }
-      bool operator<=(const Index& object)
+      bool operator<=(const Index& object) const
          { return *this < object || *this == object; }
-      bool operator>(const Index& object)
+      bool operator>(const Index& object) const
          { return !(*this <= object); }
-      bool operator>=(const Index& object)
+      bool operator>=(const Index& object) const
          { return !(*this < object); }
       constexpr static qint8 MAX_CLUSTER_SIZE {64};
    private:
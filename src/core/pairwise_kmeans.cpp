@@ -34,6 +34,8 @@ bool KMeans::fit(const QVector<Vector2>& X, int N, int K, QVector<qint8>& labels
 
       for ( int t = 0; t < MAX_ITERATIONS; ++t )
       {
+         ++_iterations;
+
          // compute new labels
          for ( int i = 0; i < N; ++i )
          {
@@ -25,6 +25,24 @@ void Matrix::readData()
    seek(0);
    stream() >> _geneSize >> _maxClusterSize >> _dataSize >> _pairSize >> _clusterSize >> _offset;
    readHeader();
+
+   // forget rows of any previously read data
+   clearRows();
+
+   // make sure header is valid so item headers read later can be used without checks
+   if ( _geneSize < 0
+        || _maxClusterSize < 0
+        || _maxClusterSize > Index::MAX_CLUSTER_SIZE
+        || _dataSize < 0
+        || _pairSize < 0
+        || _clusterSize < _pairSize
+        || _offset < 0 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Pairwise matrix header is invalid or corrupt."));
+      throw e;
+   }
 }
 
 
@@ -50,6 +68,9 @@ void Matrix::writeNewData()
 
 void Matrix::finish()
 {
+   // write any buffered items before the header is updated
+   flush();
+
    // initialize header
    seek(0);
    stream() << _geneSize << _maxClusterSize << _dataSize << _pairSize << _clusterSize << _offset;
@@ -71,6 +92,82 @@ EMetadata Matrix::geneNames() const
 
 
 
+void Matrix::append(const Matrix* matrix)
+{
+   // make sure this is new data object that can be written to
+   if ( _lastWrite == -2 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Pairwise Matrix Logical Error"));
+      e.setDetails(tr("Attempting to write data to uninitialized object."));
+      throw e;
+   }
+
+   // make sure items of the given matrix have the same layout and are valid in this
+   // matrix, a matrix over fewer genes has the pairs of the first genes of this matrix
+   if ( matrix->_geneSize > _geneSize
+        || matrix->_maxClusterSize > _maxClusterSize
+        || matrix->_dataSize != _dataSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Pairwise Matrix Logical Error"));
+      e.setDetails(tr("Cannot append a pairwise matrix with more genes, a larger max cluster size "
+                      "or a different data size."));
+      throw e;
+   }
+
+   // write any buffered items so appended items follow them
+   flush();
+
+   // copy items of the given matrix in large chunks
+   const int itemSize {_itemHeaderSize + _dataSize};
+   const qint64 chunkSize {qMax(1, _readBufferSize / itemSize)};
+   QByteArray buffer;
+   for ( qint64 i = 0; i < matrix->_clusterSize; i += chunkSize )
+   {
+      // read the next chunk of items
+      const qint64 size {qMin(chunkSize, matrix->_clusterSize - i)};
+      buffer.resize(size * itemSize);
+      matrix->readItems(i, size, buffer.data());
+
+      // make sure the chunk begins after the last item written, items within the chunk are
+      // already sorted because the given matrix was written with the same check
+      qint32 geneX;
+      qint32 geneY;
+      memcpy(&geneX, buffer.constData(), sizeof(qint32));
+      memcpy(&geneY, buffer.constData() + sizeof(qint32), sizeof(qint32));
+      qint64 indent {Index::makeIndent(geneX,geneY,buffer.at(2 * sizeof(qint32)))};
+      if ( indent <= _lastWrite )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Pairwise Matrix Logical Error"));
+         e.setDetails(tr("Attempting to write indent %1 when last written is %2.")
+                      .arg(indent).arg(_lastWrite));
+         throw e;
+      }
+
+      // write the chunk to the end of this matrix
+      seek(_headerSize + _offset + _clusterSize * itemSize);
+      writeItems(buffer.constData(), size);
+      _clusterSize += size;
+      _flushedSize = _clusterSize;
+
+      // set new last index from the last item of the chunk
+      const char* last {buffer.constData() + (size - 1) * itemSize};
+      memcpy(&geneX, last, sizeof(qint32));
+      memcpy(&geneY, last + sizeof(qint32), sizeof(qint32));
+      _lastWrite = Index::makeIndent(geneX,geneY,last[2 * sizeof(qint32)]);
+   }
+
+   // increment pair size of data object
+   _pairSize += matrix->_pairSize;
+}
+
+
+
+
+
+
 void Matrix::initialize(const EMetadata& geneNames, int maxClusterSize, int dataSize, int offset)
 {
    // make sure gene names metadata is an array and is not empty
@@ -112,6 +209,9 @@ void Matrix::initialize(const EMetadata& geneNames, int maxClusterSize, int data
    _pairSize = 0;
    _clusterSize = 0;
    _lastWrite = -1;
+   _writeBuffer.clear();
+   _writeBufferEnd = 0;
+   _flushedSize = 0;
 }
 
 
@@ -119,7 +219,35 @@ void Matrix::initialize(const EMetadata& geneNames, int maxClusterSize, int data
 
 
 
-void Matrix::write(Index index, qint8 cluster)
+void Matrix::writePair(Index index, int clusterSize, const char* data)
+{
+   // make sure cluster size of pair does not exceed max
+   if ( clusterSize > _maxClusterSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Pairwise Logical Error"));
+      e.setDetails(tr("Cannot write pair with cluster size %1 exceeding the max of %2.")
+         .arg(clusterSize)
+         .arg(_maxClusterSize));
+      throw e;
+   }
+
+   // copy each cluster, which are already encoded one after another, into the write buffer
+   for (int i = 0; i < clusterSize ;++i)
+   {
+      memcpy(write(index,i),data + (qint64)i * _dataSize,_dataSize);
+   }
+
+   // increment pair size of data object
+   ++_pairSize;
+}
+
+
+
+
+
+
+char* Matrix::write(Index index, qint8 cluster)
 {
    // make sure this is new data object that can be written to
    if ( _lastWrite == -2 )
@@ -131,23 +259,45 @@ void Matrix::write(Index index, qint8 cluster)
    }
 
    // make sure the new pair has a higher indent than the previous written so the list of
-   // all indents are sorted
-   if ( index.indent(cluster) <= _lastWrite )
+   // all indents are sorted, the cluster was already checked against the max cluster size
+   qint64 indent {index.uncheckedIndent(cluster)};
+   if ( indent <= _lastWrite )
    {
       E_MAKE_EXCEPTION(e);
       e.setTitle(tr("Pairwise Matrix Logical Error"));
       e.setDetails(tr("Attempting to write indent %1 when last written is %2.")
-                   .arg(index.indent(0)).arg(_lastWrite));
+                   .arg(indent).arg(_lastWrite));
       throw e;
    }
 
-   // seek to position for next pair and write indent value
-   seek(_headerSize + _offset + _clusterSize * (_dataSize + _itemHeaderSize));
-   stream() << index.getX() << index.getY() << cluster;
+   // allocate the write buffer to hold a whole number of items if it is not allocated
+   const int itemSize {_itemHeaderSize + _dataSize};
+   if ( _writeBuffer.isEmpty() )
+   {
+      _writeBuffer.resize(qMax(1, _writeBufferSize / itemSize) * itemSize);
+   }
+
+   // flush the write buffer if it cannot hold another item
+   if ( _writeBufferEnd + itemSize > _writeBuffer.size() )
+   {
+      flush();
+   }
+
+   // append item header to write buffer in the same layout the stream would write it
+   char* item {_writeBuffer.data() + _writeBufferEnd};
+   qint32 geneX {index.getX()};
+   qint32 geneY {index.getY()};
+   memcpy(item, &geneX, sizeof(qint32));
+   memcpy(item + sizeof(qint32), &geneY, sizeof(qint32));
+   item[2 * sizeof(qint32)] = cluster;
+   _writeBufferEnd += itemSize;
 
    // increment cluster size and set new last index
    ++_clusterSize;
-   _lastWrite = index.indent(cluster);
+   _lastWrite = indent;
+
+   // return location of item data for the pair to encode its cluster into
+   return item + _itemHeaderSize;
 }
 
 
@@ -155,16 +305,180 @@ void Matrix::write(Index index, qint8 cluster)
 
 
 
-Index Matrix::getPair(qint64 index, qint8* cluster) const
+void Matrix::flush() const
 {
-   // seek to pairwise index and read item header data
-   seekPair(index);
+   // if the write buffer is empty there is nothing to do
+   if ( _writeBufferEnd == 0 )
+   {
+      return;
+   }
+
+   // seek once to the end of all flushed items and write the buffer
+   seek(_headerSize + _offset + _flushedSize * (_dataSize + _itemHeaderSize));
+   writeItems(_writeBuffer.constData(), _clusterSize - _flushedSize);
+
+   // all items in the buffer are now in the file
+   _flushedSize = _clusterSize;
+   _writeBufferEnd = 0;
+}
+
+
+
+
+
+
+void Matrix::writeItems(const char* data, qint64 size) const
+{
+   // written items change the rows of the matrix
+   clearRows();
+
+   // write the items with one raw block write through the device of the data stream,
+   // which is laid out the same as typed writes of the stream
+   const qint64 bytes {size * (_dataSize + _itemHeaderSize)};
+
+   if ( stream().device()->write(data, bytes) != bytes )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing %1 pairwise items: %2").arg(size)
+                   .arg(stream().device()->errorString()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+Index Matrix::itemIndex(const char* item)
+{
+   // decode the pairwise index from the header of a raw item
    qint32 geneX;
    qint32 geneY;
-   stream() >> geneX >> geneY >> *cluster;
+   memcpy(&geneX, item, sizeof(qint32));
+   memcpy(&geneY, item + sizeof(qint32), sizeof(qint32));
+
+   return Index(geneX, geneY);
+}
+
+
+
+
+
+
+void Matrix::readItems(qint64 index, qint64 size, char* data) const
+{
+   // make sure the whole range of items is within the data object
+   if ( size > 0 )
+   {
+      seekPair(index + size - 1);
+   }
+   seekPair(index);
+
+   // read the items with one raw block read through the device of the data stream
+   const qint64 bytes {size * (_dataSize + _itemHeaderSize)};
+
+   if ( stream().device()->read(data, bytes) != bytes )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed reading %1 pairwise items: %2").arg(size)
+                   .arg(stream().device()->errorString()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+qint64 Matrix::lowerBound(qint64 indent, qint64 first, qint64 last) const
+{
+   // binary search for the first item in the range [first, last) whose indent is not
+   // less than the given indent
+   while ( first < last )
+   {
+      qint64 pivot {first + (last - first)/2};
+      seekPair(pivot);
+
+      // read in pairwise item header
+      qint32 geneX;
+      qint32 geneY;
+      qint8 cluster;
+      stream() >> geneX >> geneY >> cluster;
+
+      if ( Index::makeIndent(geneX,geneY,cluster) < indent )
+      {
+         first = pivot + 1;
+      }
+      else
+      {
+         last = pivot;
+      }
+   }
+
+   return first;
+}
+
+
+
+
+
+
+Matrix::Row Matrix::readRow(qint32 x) const
+{
+   return readRows(x, x + 1).first();
+}
+
+
+
+
+
+
+const Matrix::Row& Matrix::cachedRow(qint32 x) const
+{
+   // move the row to the front if it is already cached
+   for ( int i = 0; i < _rows.size(); ++i )
+   {
+      if ( _rows.at(i).x == x )
+      {
+         _rows.move(i, 0);
+         return _rows.first();
+      }
+   }
+
+   // otherwise read the row along with the rows that follow it, since neighboring rows
+   // are usually viewed together and are stored next to each other
+   QVector<Row> rows {readRows(x, qMin(x + _rowPrefetchSize, _geneSize))};
+
+   for ( int i = rows.size() - 1; i >= 0; --i )
+   {
+      // replace any cached copy of a prefetched row
+      for ( int j = 0; j < _rows.size(); ++j )
+      {
+         if ( _rows.at(j).x == rows.at(i).x )
+         {
+            _rowsSize -= _rows.at(j).items.size();
+            _rows.removeAt(j);
+            break;
+         }
+      }
 
-   // return pairwise index
-   return {geneX,geneY};
+      _rows.prepend(rows.at(i));
+      _rowsSize += rows.at(i).items.size();
+   }
+
+   // evict the least recently used rows, always keeping the requested row
+   while ( _rows.size() > 1 && _rowsSize > _rowCacheSize )
+   {
+      _rowsSize -= _rows.last().items.size();
+      _rows.removeLast();
+   }
+
+   // the returned row is valid until the next call
+   return _rows.first();
 }
 
 
@@ -183,10 +497,10 @@ qint64 Matrix::findPair(qint64 indent, qint64 first, qint64 last) const
    qint32 geneY;
    qint8 cluster;
    stream() >> geneX >> geneY >> cluster;
-   Index index(geneX,geneY);
+   qint64 pivotIndent {Index::makeIndent(geneX,geneY,cluster)};
 
    // if indent values match return index
-   if ( index.indent(cluster) == indent )
+   if ( pivotIndent == indent )
    {
       return pivot;
    }
@@ -195,7 +509,7 @@ qint64 Matrix::findPair(qint64 indent, qint64 first, qint64 last) const
    // to divide and conquer depending on the value of the pivot
    else if ( first != last )
    {
-      if ( index.indent(cluster) > indent )
+      if ( pivotIndent > indent )
       {
          // if pivot is first add one so pivot is not less than first when passed
          if ( pivot == first )
@@ -239,6 +553,9 @@ void Matrix::seekPair(qint64 index) const
       throw e;
    }
 
+   // make sure any buffered items are in the file before reading them back
+   flush();
+
    // seek to pairwise index requested making sure it worked
    seek(_headerSize + _offset + index * (_dataSize + _itemHeaderSize));
 }
@@ -248,6 +565,183 @@ void Matrix::seekPair(qint64 index) const
 
 
 
+qint64 Matrix::rowOffset(qint32 x) const
+{
+   // make sure row is within the matrix
+   if ( x < 0 || x > _geneSize )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Pairwise Matrix Logical Error"));
+      e.setDetails(tr("Row %1 is outside of the matrix.").arg(x));
+      throw e;
+   }
+
+   // initialize offsets as unknown
+   if ( _rowOffsets.isEmpty() )
+   {
+      _rowOffsets.fill(-1, _geneSize + 1);
+      _rowOffsets[_geneSize] = _clusterSize;
+   }
+
+   // find the first item of the row if it is not known yet
+   if ( _rowOffsets.at(x) == -1 )
+   {
+      _rowOffsets[x] = lowerBound(Index::makeIndent(x, 0, 0));
+   }
+
+   return _rowOffsets.at(x);
+}
+
+
+
+
+
+
+QVector<Matrix::Row> Matrix::readRows(qint32 first, qint32 last) const
+{
+   // make sure range of rows is valid
+   if ( first > last )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Pairwise Matrix Logical Error"));
+      e.setDetails(tr("Range of rows %1 to %2 is invalid.").arg(first).arg(last));
+      throw e;
+   }
+
+   // create the rows, which are filled in as their items are read
+   const int size {itemSize()};
+   QVector<Row> rows(last - first);
+
+   for ( qint32 x = first; x < last; ++x )
+   {
+      Row& row {rows[x - first]};
+      row.x = x;
+      row.itemSize = size;
+      row.starts.resize(x + 1);
+   }
+
+   // read the items of all rows sequentially in bounded chunks, splitting them into rows
+   // and finding the first item of each pair along the way
+   const qint64 begin {rowOffset(first)};
+   const qint64 count {rowOffset(last) - begin};
+   const qint64 chunkSize {qMax(1, _readBufferSize / size)};
+   QByteArray chunk(qMin(chunkSize, count) * size, 0);
+   qint32 x {first};
+   qint32 y {0};
+   qint64 rowBegin {0};
+
+   for ( qint64 chunkBegin = 0; chunkBegin < count; chunkBegin += chunkSize )
+   {
+      const qint64 chunkCount {qMin(chunkSize, count - chunkBegin)};
+
+      readItems(begin + chunkBegin, chunkCount, chunk.data());
+
+      for ( qint64 j = 0; j < chunkCount; ++j )
+      {
+         const qint64 i {chunkBegin + j};
+         const char* item {chunk.constData() + j * size};
+         Index index {itemIndex(item)};
+
+         // pairs without items start where the next pair with items starts, which is
+         // the end of the row for the remaining pairs of a finished row
+         while ( x < last && index.getX() != x )
+         {
+            while ( y <= x )
+            {
+               rows[x - first].starts[y++] = i - rowBegin;
+            }
+
+            ++x;
+            y = 0;
+            rowBegin = i;
+         }
+
+         while ( y <= index.getY() )
+         {
+            rows[x - first].starts[y++] = i - rowBegin;
+         }
+
+         rows[x - first].items.append(item, size);
+      }
+   }
+
+   // finish the last row with items and any empty rows after it
+   for ( ; x < last; ++x, y = 0, rowBegin = count )
+   {
+      while ( y <= x )
+      {
+         rows[x - first].starts[y++] = count - rowBegin;
+      }
+   }
+
+   return rows;
+}
+
+
+
+
+
+
+Matrix::Row Matrix::readGene(qint32 gene) const
+{
+   // read the pairs of the gene with the genes before it, which are its row
+   Row row {readRow(gene)};
+   row.starts.resize(_geneSize + 1);
+
+   // find the pair of the gene with each gene after it in the row of that gene, which
+   // only searches within the row since the row offsets are known
+   const int size {itemSize()};
+   QByteArray items(_maxClusterSize * size, 0);
+   int end {row.starts.at(gene)};
+
+   for ( qint32 x = gene + 1; x < _geneSize; ++x )
+   {
+      row.starts[x] = end;
+
+      const qint64 rowEnd {rowOffset(x + 1)};
+      const qint64 first {lowerBound(Index::makeIndent(x, gene, 0), rowOffset(x), rowEnd)};
+      const qint64 count {qMin((qint64)_maxClusterSize, rowEnd - first)};
+
+      if ( count == 0 )
+      {
+         continue;
+      }
+
+      readItems(first, count, items.data());
+
+      // keep the items of the pair, which are followed by the items of later pairs
+      int k {0};
+      while ( k < count && itemIndex(items.constData() + k * size) == Index(x, gene) )
+      {
+         ++k;
+      }
+
+      row.items.append(items.constData(), k * size);
+      end += k;
+   }
+
+   row.starts[_geneSize] = end;
+
+   return row;
+}
+
+
+
+
+
+
+void Matrix::clearRows() const
+{
+   _rowOffsets.clear();
+   _rows.clear();
+   _rowsSize = 0;
+}
+
+
+
+
+
+
 void Matrix::Pair::write(Index index)
 {
    // make sure cluster size of pair does not exceed max
@@ -261,11 +755,10 @@ void Matrix::Pair::write(Index index)
       throw e;
    }
 
-   // go through each cluster and write it to data object
+   // go through each cluster and encode it into the write buffer of the data object
    for (int i = 0; i < clusterSize() ;++i)
    {
-      _matrix->write(index,i);
-      writeCluster(_matrix->stream(),i);
+      writeCluster(_matrix->write(index,i),i);
    }
 
    // increment pair size of data object
@@ -285,11 +778,42 @@ void Matrix::Pair::read(Index index) const
    // attempt to find cluster index within data object
    qint64 clusterIndex;
    if ( _cMatrix->_clusterSize > 0
-        && (clusterIndex = _cMatrix->findPair(index.indent(0),0,_cMatrix->_clusterSize - 1)) != -1 )
+        && (clusterIndex = _cMatrix->findPair(index.uncheckedIndent(0),0,_cMatrix->_clusterSize - 1)) != -1 )
    {
-      // pair found, read in all clusters
+      // pair found, read in all clusters without reading ahead past the largest pair
       _rawIndex = clusterIndex;
-      readNext();
+      readPair(_cMatrix->_maxClusterSize);
+   }
+}
+
+
+
+
+
+
+void Matrix::Pair::read(const Row& row, qint32 y) const
+{
+   // clear any existing clusters
+   clearClusters();
+
+   // read in all clusters of the pair from the items of its row
+   const int size {row.clusterSize(y)};
+
+   addCluster(size);
+
+   for ( int k = 0; k < size; ++k )
+   {
+      readCluster(itemData(row.item(y, k)), k);
+   }
+
+   // rows read by gene also have pairs with genes after the row gene
+   if ( y < row.x )
+   {
+      _index = {row.x, y};
+   }
+   else
+   {
+      _index = {y, row.x};
    }
 }
 
@@ -299,6 +823,18 @@ void Matrix::Pair::read(Index index) const
 
 
 void Matrix::Pair::readNext() const
+{
+   // read next pair reading ahead as many items as fit in the read buffer
+   const int itemSize {_cMatrix->_itemHeaderSize + _cMatrix->_dataSize};
+   readPair(qMax(1, _readBufferSize / itemSize));
+}
+
+
+
+
+
+
+void Matrix::Pair::readPair(qint64 readAhead) const
 {
    // make sure read next index is not already at end of data object
    if ( _rawIndex < _cMatrix->_clusterSize )
@@ -307,8 +843,12 @@ void Matrix::Pair::readNext() const
       clearClusters();
 
       // get to first cluster
-      qint8 cluster;
-      Index index {_cMatrix->getPair(_rawIndex++,&cluster)};
+      const char* data {item(_rawIndex++,readAhead)};
+      qint32 geneX;
+      qint32 geneY;
+      memcpy(&geneX, data, sizeof(qint32));
+      memcpy(&geneY, data + sizeof(qint32), sizeof(qint32));
+      qint8 cluster {(qint8)data[2 * sizeof(qint32)]};
 
       // make sure this is cluster 0
       if ( cluster != 0 )
@@ -321,15 +861,16 @@ void Matrix::Pair::readNext() const
 
       // add first cluster, read it in, and save pairwise index
       addCluster();
-      readCluster(_cMatrix->stream(),0);
-      _index = index;
+      readCluster(data + _itemHeaderSize,0);
+      _index = {geneX,geneY};
 
       // read in remaining clusters for pair
       qint8 count {1};
       while ( _rawIndex < _cMatrix->_clusterSize )
       {
          // get next pair cluster
-         _cMatrix->getPair(_rawIndex++,&cluster);
+         data = item(_rawIndex++,readAhead);
+         cluster = data[2 * sizeof(qint32)];
 
          // if cluster is zero this is the next pair so break from loop
          if ( cluster == 0 )
@@ -345,13 +886,38 @@ void Matrix::Pair::readNext() const
             e.setTitle(tr("Pairwise Logical Error"));
             e.setDetails(tr("Cannot read pair with cluster size %1 exceeding the max of %2.")
                .arg(count)
-               .arg(_matrix->_maxClusterSize));
+               .arg(_cMatrix->_maxClusterSize));
             throw e;
          }
 
          // add new cluster and read it in
          addCluster();
-         readCluster(_cMatrix->stream(),cluster);
+         readCluster(data + _itemHeaderSize,cluster);
+      }
+   }
+}
+
+
+
+
+
+
+const char* Matrix::Pair::item(qint64 index, qint64 readAhead) const
+{
+   const int itemSize {_cMatrix->_itemHeaderSize + _cMatrix->_dataSize};
+
+   // if the item is not in the read buffer then read it and the items after it
+   if ( index < _bufferStart || index >= _bufferStart + _bufferSize )
+   {
+      _bufferStart = index;
+      _bufferSize = qMin(readAhead, _cMatrix->_clusterSize - index);
+      if ( _buffer.size() < _bufferSize * itemSize )
+      {
+         _buffer.resize(_bufferSize * itemSize);
       }
+      _cMatrix->readItems(_bufferStart, _bufferSize, _buffer.data());
    }
+
+   // return location of item within the read buffer
+   return _buffer.constData() + (index - _bufferStart) * itemSize;
 }
@@ -12,6 +12,21 @@ namespace Pairwise
    {
    public:
       class Pair;
+      // items of the pairs of gene x with each partner gene y, where the items of the
+      // pair with y start at starts[y] and the last start is the end of the items, so a
+      // row read with readRow() has the partners y < x and one read with readGene() has
+      // all partners
+      class Row
+      {
+      public:
+         int clusterSize(qint32 y) const { return starts.at(y + 1) - starts.at(y); }
+         const char* item(qint32 y, int cluster) const
+            { return items.constData() + (qint64)(starts.at(y) + cluster) * itemSize; }
+         qint32 x {-1};
+         int itemSize {0};
+         QByteArray items;
+         QVector<int> starts;
+      };
       virtual qint64 dataEnd() const override final;
       virtual void readData() override final;
       virtual void writeNewData() override final;
@@ -19,18 +34,39 @@ namespace Pairwise
       int geneSize() const { return _geneSize; }
       int maxClusterSize() const { return _maxClusterSize; }
       qint64 size() const { return _pairSize; }
+      qint64 clusterSize() const { return _clusterSize; }
       EMetadata geneNames() const;
+      void append(const Matrix* matrix);
+      void writePair(Index index, int clusterSize, const char* data);
+      void readItems(qint64 index, qint64 size, char* data) const;
+      qint64 lowerBound(qint64 indent) const { return lowerBound(indent, 0, _clusterSize); }
+      qint64 lowerBound(qint64 indent, qint64 first, qint64 last) const;
+      Row readRow(qint32 x) const;
+      QVector<Row> readRows(qint32 first, qint32 last) const;
+      Row readGene(qint32 gene) const;
+      const Row& cachedRow(qint32 x) const;
+      int itemSize() const { return _itemHeaderSize + _dataSize; }
+      static Index itemIndex(const char* item);
+      static qint8 itemCluster(const char* item) { return item[2 * sizeof(qint32)]; }
+      static const char* itemData(const char* item) { return item + _itemHeaderSize; }
    protected:
       virtual void writeHeader() = 0;
       virtual void readHeader() = 0;
       void initialize(const EMetadata& geneNames, int maxClusterSize, int dataSize, int offset);
    private:
-      void write(Index index, qint8 cluster);
-      Index getPair(qint64 index, qint8* cluster) const;
+      char* write(Index index, qint8 cluster);
+      void flush() const;
+      void writeItems(const char* data, qint64 size) const;
       qint64 findPair(qint64 indent, qint64 first, qint64 last) const;
       void seekPair(qint64 index) const;
+      qint64 rowOffset(qint32 x) const;
+      void clearRows() const;
       constexpr static int _headerSize {30};
       constexpr static int _itemHeaderSize {9};
+      constexpr static int _writeBufferSize {8*1024*1024};
+      constexpr static int _readBufferSize {8*1024*1024};
+      constexpr static int _rowCacheSize {32*1024*1024};
+      constexpr static int _rowPrefetchSize {4};
       qint32 _geneSize {0};
       qint32 _maxClusterSize {0};
       qint32 _dataSize {0};
@@ -38,6 +74,17 @@ namespace Pairwise
       qint64 _clusterSize {0};
       qint16 _offset {0};
       qint64 _lastWrite {-2};
+      // items written since the last flush, encoded exactly as they are stored in the
+      // file so they can be appended with one sequential write
+      mutable QByteArray _writeBuffer;
+      mutable int _writeBufferEnd {0};
+      mutable qint64 _flushedSize {0};
+      // item index of the first item of each row, found when first needed
+      mutable QVector<qint64> _rowOffsets;
+      // recently read rows with the most recently used first, limited to _rowCacheSize
+      // bytes of items
+      mutable QList<Row> _rows;
+      mutable qint64 _rowsSize {0};
    };
 
 
@@ -63,6 +110,7 @@ namespace Pairwise
       virtual bool isEmpty() const = 0;
       void write(Index index);
       void read(Index index) const;
+      void read(const Row& row, qint32 y) const;
       void reset() const { _rawIndex = 0; };
       void readNext() const;
       bool hasNext() const { return _rawIndex != _cMatrix->_clusterSize; }
@@ -70,13 +118,19 @@ namespace Pairwise
       Pair& operator=(const Pair&) = default;
       Pair& operator=(Pair&&) = default;
    protected:
-      virtual void writeCluster(EDataStream& stream, int cluster) = 0;
-      virtual void readCluster(const EDataStream& stream, int cluster) const = 0;
+      virtual void writeCluster(char* data, int cluster) = 0;
+      virtual void readCluster(const char* data, int cluster) const = 0;
    private:
+      void readPair(qint64 readAhead) const;
+      const char* item(qint64 index, qint64 readAhead) const;
       Matrix* _matrix {nullptr};
       const Matrix* _cMatrix;
       mutable qint64 _rawIndex {0};
       mutable Index _index;
+      // items read ahead from the data object, starting at item index _bufferStart
+      mutable QByteArray _buffer;
+      mutable qint64 _bufferStart {0};
+      mutable qint64 _bufferSize {0};
    };
 }
 
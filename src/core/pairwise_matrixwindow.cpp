@@ -0,0 +1,168 @@
+#include "pairwise_matrixwindow.h"
+
+
+
+using namespace Pairwise;
+
+
+
+
+
+
+MatrixWindow::MatrixWindow(const Matrix* matrix, const Matrix* clusterMatrix, qint64 windowSize):
+   _matrix(matrix),
+   _clusterMatrix(clusterMatrix),
+   _windowSize(qMax(windowSize, (qint64)Index::MAX_CLUSTER_SIZE + 1)),
+   _end(matrix->clusterSize())
+{}
+
+
+
+
+
+
+void MatrixWindow::setRange(qint64 begin, qint64 end)
+{
+   // restrict the following windows to the given range of items, which must start and
+   // end at pair boundaries
+   _next = begin;
+   _end = end;
+   _size = 0;
+
+   // move the cluster matrix to the first item of the pair at the beginning of the range
+   if ( _clusterMatrix && begin < end )
+   {
+      QByteArray first(_matrix->itemSize(), 0);
+      _matrix->readItems(begin, 1, first.data());
+
+      _clusterItems.clear();
+      _clusterFront = 0;
+      _clusterNext = _clusterMatrix->lowerBound(Matrix::itemIndex(first.constData()).uncheckedIndent(0));
+   }
+}
+
+
+
+
+
+
+bool MatrixWindow::next()
+{
+   // move past the items of the previous window
+   _next += _size;
+   _size = 0;
+
+   if ( _next >= _end )
+   {
+      return false;
+   }
+
+   // read window of items
+   _size = qMin(_windowSize, _end - _next);
+   _items.resize(_size * _matrix->itemSize());
+   _matrix->readItems(_next, _size, _items.data());
+
+   // leave the last pair for the next window if it may continue there
+   if ( _next + _size < _end )
+   {
+      Index last {index(_size - 1)};
+
+      while ( _size > 1 && index(_size - 1) == last )
+      {
+         --_size;
+      }
+   }
+
+   // remove cluster matrix items passed in previous windows
+   _clusterItems.remove(0, _clusterFront * (_clusterMatrix ? _clusterMatrix->itemSize() : 0));
+   _clusterFront = 0;
+
+   // find the cluster size of each pair and the cluster matrix item of each cluster of
+   // pairs with multiple clusters
+   _clusterSizes.resize(_size);
+   _clusterOffsets.fill(-1, _size);
+
+   for ( qint64 i = 0; i < _size; )
+   {
+      Index pair {index(i)};
+      qint64 end {i + 1};
+
+      while ( end < _size && index(end) == pair )
+      {
+         ++end;
+      }
+
+      for ( qint64 k = i; k < end; ++k )
+      {
+         _clusterSizes[k] = end - i;
+
+         if ( _clusterMatrix && end - i > 1 )
+         {
+            findClusterItem(k, pair.uncheckedIndent(cluster(k)));
+         }
+      }
+
+      i = end;
+   }
+
+   return true;
+}
+
+
+
+
+
+
+const char* MatrixWindow::clusterData(qint64 i) const
+{
+   qint64 offset {_clusterOffsets.at(i)};
+
+   return (offset >= 0) ? _clusterItems.constData() + offset : nullptr;
+}
+
+
+
+
+
+
+void MatrixWindow::findClusterItem(qint64 i, qint64 indent)
+{
+   const int itemSize {_clusterMatrix->itemSize()};
+   const qint64 READ_SIZE {4096};
+
+   while ( true )
+   {
+      // read more cluster matrix items if all read items were passed
+      if ( _clusterFront * itemSize == _clusterItems.size() )
+      {
+         if ( _clusterNext == _clusterMatrix->clusterSize() )
+         {
+            return;
+         }
+
+         qint64 count {qMin(READ_SIZE, _clusterMatrix->clusterSize() - _clusterNext)};
+         qint64 offset {_clusterItems.size()};
+         _clusterItems.resize(offset + count * itemSize);
+         _clusterMatrix->readItems(_clusterNext, count, _clusterItems.data() + offset);
+         _clusterNext += count;
+      }
+
+      // stop at the first item that is not before the given indent, saving its location if
+      // it is the item of the given cluster
+      const char* item {_clusterItems.constData() + _clusterFront * itemSize};
+      qint64 itemIndent {Matrix::itemIndex(item).uncheckedIndent(Matrix::itemCluster(item))};
+
+      if ( itemIndent > indent )
+      {
+         return;
+      }
+
+      ++_clusterFront;
+
+      if ( itemIndent == indent )
+      {
+         _clusterOffsets[i] = (item - _clusterItems.constData()) + (Matrix::itemData(item) - item);
+         return;
+      }
+   }
+}
@@ -0,0 +1,44 @@
+#ifndef PAIRWISE_MATRIXWINDOW_H
+#define PAIRWISE_MATRIXWINDOW_H
+#include "pairwise_matrix.h"
+
+
+
+namespace Pairwise
+{
+   // reads the raw items of a matrix in windows of whole pairs, along with the items of
+   // a cluster matrix for the clusters of pairs that have more than one cluster
+   class MatrixWindow
+   {
+   public:
+      MatrixWindow(const Matrix* matrix, const Matrix* clusterMatrix, qint64 windowSize);
+      void setRange(qint64 begin, qint64 end);
+      bool next();
+      qint64 size() const { return _size; }
+      const char* item(qint64 i) const { return _items.constData() + i * _matrix->itemSize(); }
+      Index index(qint64 i) const { return Matrix::itemIndex(item(i)); }
+      qint8 cluster(qint64 i) const { return Matrix::itemCluster(item(i)); }
+      const char* data(qint64 i) const { return Matrix::itemData(item(i)); }
+      int clusterSize(qint64 i) const { return _clusterSizes.at(i); }
+      const char* clusterData(qint64 i) const;
+   private:
+      void findClusterItem(qint64 i, qint64 indent);
+      const Matrix* _matrix;
+      const Matrix* _clusterMatrix;
+      qint64 _windowSize;
+      qint64 _next {0};
+      qint64 _end;
+      qint64 _size {0};
+      QByteArray _items;
+      QVector<qint8> _clusterSizes;
+      QVector<qint64> _clusterOffsets;
+      // cluster matrix items read so far that have not been passed by a previous window
+      QByteArray _clusterItems;
+      qint64 _clusterNext {0};
+      qint64 _clusterFront {0};
+   };
+}
+
+
+
+#endif
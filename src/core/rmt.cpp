@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <memory>
 #include <random>
+#include <QtConcurrent>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
 #include <gsl/gsl_vector.h>
@@ -9,6 +11,8 @@
 #include "rmt.h"
 #include "rmt_input.h"
 #include "correlationmatrix.h"
+#include "correlationmatrix_thresholdindex.h"
+#include "pairwise_matrixwindow.h"
 #include "datafactory.h"
 
 
@@ -44,9 +48,23 @@ void RMT::process(const EAbstractAnalytic::Block* result)
 
    float threshold {_thresholdStart};
 
-   // load raw correlation data, row-wise maximums
-   QVector<float> matrix {_input->dumpRawData()};
-   QVector<float> maximums {computeMaximums(matrix)};
+   QVector<Profile> profiles;
+   QElapsedTimer totalTimer;
+   QElapsedTimer timer;
+
+   totalTimer.start();
+
+   // load correlations that can be part of a pruned matrix and row-wise maximums,
+   // then sort the correlations so that each threshold only visits the ones above it
+   QVector<float> maximums;
+
+   timer.start();
+   QVector<Edge> edges {loadEdges(&maximums)};
+   qint64 loadTime {timer.nsecsElapsed()};
+
+   timer.start();
+   sortEdges(&edges);
+   qint64 sortTime {timer.nsecsElapsed()};
 
    // continue while max chi is less than final threshold
    while ( maxChi < _chiSquareThreshold2 )
@@ -54,9 +72,14 @@ void RMT::process(const EAbstractAnalytic::Block* result)
       qInfo("\n");
       qInfo("threshold: %g", threshold);
 
+      Profile profile {threshold, 0, 0, 0, 0, -1, 0, 0, 0};
+
       // compute pruned matrix based on threshold
       int size;
-      QVector<float> pruneMatrix {computePruneMatrix(matrix, maximums, threshold, &size)};
+      timer.start();
+      QVector<float> pruneMatrix {computePruneMatrix(edges, maximums, threshold, &size, &profile.edges)};
+      profile.pruneTime = timer.nsecsElapsed();
+      profile.size = size;
 
       qInfo("prune matrix: %d", size);
 
@@ -66,16 +89,24 @@ void RMT::process(const EAbstractAnalytic::Block* result)
       if ( size > 0 )
       {
          // compute eigenvalues of pruned matrix
+         timer.start();
          QVector<float> eigens {computeEigenvalues(&pruneMatrix, size)};
+         profile.eigenTime = timer.nsecsElapsed();
+         profile.eigenvalues = eigens.size();
 
          qInfo("eigenvalues: %d", eigens.size());
 
          // compute chi-square value from NNSD of eigenvalues
-         chi = computeChiSquare(eigens);
+         timer.start();
+         chi = computeChiSquare(eigens, &profile.uniqueEigenvalues);
+         profile.chiTime = timer.nsecsElapsed();
 
          qInfo("chi-square: %g", chi);
       }
 
+      profile.chi = chi;
+      profiles.append(profile);
+
       // make sure that chi-square test succeeded
       if ( chi != -1 )
       {
@@ -96,10 +127,13 @@ void RMT::process(const EAbstractAnalytic::Block* result)
       // output to log file
       stream << threshold << "\t" << size << "\t" << chi << "\n";
 
-      // decrement threshold and fail if minimum threshold is reached
+      // decrement threshold and fail if minimum threshold is reached, keeping the
+      // profile of the failed search since it is the one most worth looking at
       threshold -= _thresholdStep;
       if ( threshold < _thresholdStop )
       {
+         writeProfile(profiles, loadTime, sortTime, totalTimer.nsecsElapsed());
+
          E_MAKE_EXCEPTION(e);
          e.setTitle(tr("RMT Threshold Error"));
          e.setDetails(tr("Could not find non-random threshold above stopping threshold."));
@@ -107,6 +141,8 @@ void RMT::process(const EAbstractAnalytic::Block* result)
       }
    }
 
+   writeProfile(profiles, loadTime, sortTime, totalTimer.nsecsElapsed());
+
    // write threshold where chi was first above final threshold
    stream << finalThreshold << "\n";
 }
@@ -161,37 +197,64 @@ void RMT::initialize()
 
 
 
-QVector<float> RMT::computeMaximums(const QVector<float>& matrix)
+QVector<RMT::Edge> RMT::loadEdges(QVector<float>* maximums)
 {
    const int N {_input->geneSize()};
    const int K {_input->maxClusterSize()};
 
-   // initialize elements to minimum value
-   QVector<float> maximums(N * K, 0);
+   // initialize row-wise maximums to minimum value
+   maximums->fill(0, N * K);
+
+   // read the whole correlation matrix if there is no threshold index, otherwise read
+   // only the blocks with correlations at or above the stopping threshold
+   QVector<CorrelationMatrix::ThresholdIndex::Block> ranges;
+
+   if ( _index )
+   {
+      CorrelationMatrix::ThresholdIndex index(_input);
+      index.load(_index);
+
+      ranges = index.select(_thresholdStop, 1);
+   }
+   else
+   {
+      ranges.append({0, _input->clusterSize(), 0, 1});
+   }
 
-   // compute maximum of each row/column
-   for ( int i = 0; i < N; ++i )
+   // keep only the correlations at or above the stopping threshold, since smaller
+   // correlations are never part of a pruned matrix
+   QVector<Edge> edges;
+   Pairwise::MatrixWindow window(_input, nullptr, 65536);
+
+   for ( auto& range : ranges )
    {
-      for ( int j = 0; j < i; ++j )
+      window.setRange(range.begin, range.begin + range.size);
+
+      while ( window.next() )
       {
-         for ( int k = 0; k < K; ++k )
+         for ( qint64 w = 0; w < window.size(); ++w )
          {
-            float correlation = fabs(matrix[i * N * K + j * K + k]);
+            Pairwise::Index pair {window.index(w)};
+            int k = window.cluster(w);
+            float correlation;
+            memcpy(&correlation, window.data(w), sizeof(float));
 
-            if ( maximums[i * K + k] < correlation )
+            if ( !(fabs(correlation) >= _thresholdStop) )
             {
-               maximums[i * K + k] = correlation;
+               continue;
             }
 
-            if ( maximums[j * K + k] < correlation )
-            {
-               maximums[j * K + k] = correlation;
-            }
+            Edge edge {pair.getX() * K + k, pair.getY() * K + k, correlation};
+
+            (*maximums)[edge.row1] = max((*maximums)[edge.row1], fabs(correlation));
+            (*maximums)[edge.row2] = max((*maximums)[edge.row2], fabs(correlation));
+
+            edges.append(edge);
          }
       }
    }
 
-   return maximums;
+   return edges;
 }
 
 
@@ -199,47 +262,63 @@ QVector<float> RMT::computeMaximums(const QVector<float>& matrix)
 
 
 
-QVector<float> RMT::computePruneMatrix(const QVector<float>& matrix, const QVector<float>& maximums, float threshold, int* size)
+void RMT::sortEdges(QVector<Edge>* edges)
 {
-   const int N {_input->geneSize()};
-   const int K {_input->maxClusterSize()};
+   // sort edges by descending absolute correlation, so that the edges at or above any
+   // threshold are a prefix of the edge list
+   std::sort(edges->begin(), edges->end(), [](const Edge& a, const Edge& b)
+   {
+      return fabs(a.correlation) > fabs(b.correlation);
+   });
+}
+
+
+
+
+
 
-   // generate vector of row/column indices that have a correlation above threshold
+QVector<float> RMT::computePruneMatrix(const QVector<Edge>& edges, const QVector<float>& maximums, float threshold, int* size, qint64* edgeSize)
+{
+   // generate vector of row/column indices that have a correlation above threshold,
+   // along with the position of each row in the pruned matrix
    QVector<int> indices;
+   QVector<int> positions(maximums.size(), -1);
 
    for ( int i = 0; i < maximums.size(); ++i )
    {
       if ( maximums[i] >= threshold )
       {
+         positions[i] = indices.size();
          indices.append(i);
       }
    }
 
-   // extract pruned matrix from correlation matrix
-   QVector<float> pruneMatrix(indices.size() * indices.size());
-
-   for ( int i = 0; i < indices.size(); ++i )
+   // find the edges at or above the threshold, which are a prefix of the sorted edges
+   auto end = std::partition_point(edges.begin(), edges.end(), [threshold](const Edge& edge)
    {
-      for ( int j = 0; j < i; ++j )
-      {
-         if ( indices[i] % K != indices[j] % K )
-         {
-            continue;
-         }
+      return fabs(edge.correlation) >= threshold;
+   });
 
-         float correlation = matrix[indices[i]/K * N * K + indices[j]/K * K + indices[i] % K];
+   // extract pruned matrix from edges, filling its lower triangle
+   const int n {indices.size()};
+   QVector<float> pruneMatrix(n * n);
 
-         if ( fabs(correlation) >= threshold )
-         {
-            pruneMatrix[i * indices.size() + j] = correlation;
-         }
-      }
+   for ( auto it = edges.begin(); it != end; ++it )
+   {
+      int i = positions[it->row1];
+      int j = positions[it->row2];
 
-      pruneMatrix[i * indices.size() + i] = 1;
+      pruneMatrix[max(i, j) * n + min(i, j)] = it->correlation;
+   }
+
+   for ( int i = 0; i < n; ++i )
+   {
+      pruneMatrix[i * n + i] = 1;
    }
 
-   // save size of pruned matrix
-   *size = indices.size();
+   // save size and number of edges of pruned matrix
+   *size = n;
+   *edgeSize = end - edges.begin();
 
    return pruneMatrix;
 }
@@ -286,10 +365,11 @@ QVector<float> RMT::computeEigenvalues(QVector<float>* pruneMatrix, int size)
 
 
 
-float RMT::computeChiSquare(const QVector<float>& eigens)
+float RMT::computeChiSquare(const QVector<float>& eigens, int* uniqueSize)
 {
    // compute unique eigenvalues
    QVector<float> unique {degenerate(eigens)};
+   *uniqueSize = unique.size();
 
    qInfo("unique eigenvalues: %d", unique.size());
 
@@ -299,19 +379,39 @@ float RMT::computeChiSquare(const QVector<float>& eigens)
       return -1;
    }
 
-   // perform several chi-square tests by varying the pace
-   float chi {0.0};
-   int chiTestCount {0};
+   // determine the paces for which there are enough eigenvalues
+   QVector<int> paces;
 
    for ( int pace = _minUnfoldingPace; pace <= _maxUnfoldingPace; ++pace )
    {
-      // perform test only if there are enough eigenvalues for pace
       if ( unique.size() / pace < 5 )
       {
          break;
       }
 
-      chi += computePaceChiSquare(unique, pace);
+      paces.append(pace);
+   }
+
+   // perform a chi-square test for each pace in parallel, since each test fits its own
+   // spline over the eigenvalues
+   QVector<float> paceChis(paces.size());
+   const int* firstPace {paces.constData()};
+
+   QtConcurrent::blockingMap(paces, [&](int& pace)
+   {
+      paceChis[&pace - firstPace] = computePaceChiSquare(unique, pace);
+   });
+
+   // sum the chi-square values in order of pace so the result does not depend on
+   // the order in which the tests finish
+   float chi {0.0};
+   int chiTestCount {0};
+
+   for ( int i = 0; i < paces.size(); ++i )
+   {
+      qInfo("pace: %d, chi: %g", paces[i], paceChis[i]);
+
+      chi += paceChis[i];
       ++chiTestCount;
    }
 
@@ -332,17 +432,33 @@ float RMT::computePaceChiSquare(const QVector<float>& eigens, int pace)
    // compute eigenvalue spacings
    QVector<float> spacings {unfold(eigens, pace)};
 
-   // compute nearest-neighbor spacing distribution
+   // compute nearest-neighbor spacing distribution, computing the bin of every
+   // spacing in a separate loop without branches so that it can be vectorized; spacings
+   // out of the histogram range, including infinite and NAN spacings, are range-checked
+   // as floats before conversion and given bin -1
    const float histogramMin {0};
    const float histogramMax {3};
    const float histogramBinWidth {(histogramMax - histogramMin) / _histogramBinSize};
+   const int numSpacings {spacings.size()};
+   const float* spacingData {spacings.constData()};
+   QVector<int> bins(numSpacings);
+   int* binData {bins.data()};
+
+   for ( int i = 0; i < numSpacings; ++i )
+   {
+      const float spacing {spacingData[i]};
+      const bool inRange {histogramMin <= spacing && spacing < histogramMax};
+
+      binData[i] = inRange ? (int)((spacing - histogramMin) / histogramBinWidth) : -1;
+   }
+
    QVector<float> histogram(_histogramBinSize);
 
-   for ( auto& spacing : spacings )
+   for ( int i = 0; i < numSpacings; ++i )
    {
-      if ( histogramMin <= spacing && spacing < histogramMax )
+      if ( 0 <= binData[i] && binData[i] < _histogramBinSize )
       {
-         ++histogram[(spacing - histogramMin) / histogramBinWidth];
+         ++histogram[binData[i]];
       }
    }
 
@@ -361,8 +477,6 @@ float RMT::computePaceChiSquare(const QVector<float>& eigens, int pace)
       chi += (O_i - E_i) * (O_i - E_i) / E_i;
    }
 
-   qInfo("pace: %d, chi: %g", pace, chi);
-
    return chi;
 }
 
@@ -437,3 +551,96 @@ QVector<float> RMT::unfold(const QVector<float>& eigens, int pace)
 
    return spacings;
 }
+
+
+
+
+
+
+void RMT::writeProfile(const QVector<Profile>& profiles, qint64 loadTime, qint64 sortTime, qint64 totalTime)
+{
+   if ( !_profileFile )
+   {
+      return;
+   }
+
+   // sum the time spent in each stage over all thresholds
+   qint64 pruneTime {0};
+   qint64 eigenTime {0};
+   qint64 chiTime {0};
+
+   for ( auto& profile : profiles )
+   {
+      pruneTime += profile.pruneTime;
+      eigenTime += profile.eigenTime;
+      chiTime += profile.chiTime;
+   }
+
+   QByteArray text;
+
+   // write one row per threshold if the profile is a CSV file, otherwise write JSON
+   // with the thresholds and a summary
+   if ( QFileInfo(_profileFile->fileName()).suffix().toLower() == "csv" )
+   {
+      QTextStream stream(&text);
+
+      stream << "threshold,size,edges,eigenvalues,unique_eigenvalues,chi,prune_seconds,eigen_seconds,chi_seconds\n";
+
+      for ( auto& profile : profiles )
+      {
+         stream << profile.threshold
+            << "," << profile.size
+            << "," << profile.edges
+            << "," << profile.eigenvalues
+            << "," << profile.uniqueEigenvalues
+            << "," << profile.chi
+            << "," << profile.pruneTime / 1e9
+            << "," << profile.eigenTime / 1e9
+            << "," << profile.chiTime / 1e9
+            << "\n";
+      }
+   }
+   else
+   {
+      QJsonArray thresholds;
+
+      for ( auto& profile : profiles )
+      {
+         QJsonObject object;
+         object.insert("threshold", profile.threshold);
+         object.insert("size", profile.size);
+         object.insert("edges", (double)profile.edges);
+         object.insert("eigenvalues", profile.eigenvalues);
+         object.insert("uniqueEigenvalues", profile.uniqueEigenvalues);
+         object.insert("chi", profile.chi);
+         object.insert("pruneSeconds", profile.pruneTime / 1e9);
+         object.insert("eigenSeconds", profile.eigenTime / 1e9);
+         object.insert("chiSeconds", profile.chiTime / 1e9);
+         thresholds.append(object);
+      }
+
+      QJsonObject summary;
+      summary.insert("thresholds", profiles.size());
+      summary.insert("loadSeconds", loadTime / 1e9);
+      summary.insert("sortSeconds", sortTime / 1e9);
+      summary.insert("pruneSeconds", pruneTime / 1e9);
+      summary.insert("eigenSeconds", eigenTime / 1e9);
+      summary.insert("chiSeconds", chiTime / 1e9);
+      summary.insert("totalSeconds", totalTime / 1e9);
+
+      QJsonObject root;
+      root.insert("summary", summary);
+      root.insert("thresholds", thresholds);
+
+      text = QJsonDocument(root).toJson();
+   }
+
+   // make sure writing profile file worked
+   if ( _profileFile->write(text) == -1 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing profile file: %1").arg(_profileFile->errorString()));
+      throw e;
+   }
+}
@@ -18,16 +18,41 @@ public:
    virtual EAbstractAnalytic::Input* makeInput() override final;
    virtual void initialize();
 private:
-   QVector<float> computeMaximums(const QVector<float>& matrix);
-   QVector<float> computePruneMatrix(const QVector<float>& matrix, const QVector<float>& maximums, float threshold, int* size);
+   // sizes and timings of the evaluation of one threshold, with times in nanoseconds
+   struct Profile
+   {
+      float threshold;
+      int size;
+      qint64 edges;
+      int eigenvalues;
+      int uniqueEigenvalues;
+      float chi;
+      qint64 pruneTime;
+      qint64 eigenTime;
+      qint64 chiTime;
+   };
+   // correlation between two rows of the correlation matrix, where each row is a
+   // gene and cluster index
+   struct Edge
+   {
+      int row1;
+      int row2;
+      float correlation;
+   };
+   QVector<Edge> loadEdges(QVector<float>* maximums);
+   void sortEdges(QVector<Edge>* edges);
+   QVector<float> computePruneMatrix(const QVector<Edge>& edges, const QVector<float>& maximums, float threshold, int* size, qint64* edgeSize);
    QVector<float> computeEigenvalues(QVector<float>* pruneMatrix, int size);
-   float computeChiSquare(const QVector<float>& eigens);
+   float computeChiSquare(const QVector<float>& eigens, int* uniqueSize);
    float computePaceChiSquare(const QVector<float>& eigens, int pace);
    QVector<float> degenerate(const QVector<float>& eigens);
    QVector<float> unfold(const QVector<float>& eigens, int pace);
+   void writeProfile(const QVector<Profile>& profiles, qint64 loadTime, qint64 sortTime, qint64 totalTime);
 
    CorrelationMatrix* _input {nullptr};
    QFile* _logfile {nullptr};
+   QFile* _index {nullptr};
+   QFile* _profileFile {nullptr};
    float _thresholdStart {0.99};
    float _thresholdStep {0.001};
    float _thresholdStop {0.5};
@@ -39,6 +39,8 @@ EAbstractAnalytic::Input::Type RMT::Input::type(int index) const
    case MinUnfoldingPace: return Type::Integer;
    case MaxUnfoldingPace: return Type::Integer;
    case HistogramBinSize: return Type::Integer;
+   case IndexFile: return Type::FileIn;
+   case ProfileFile: return Type::FileOut;
    default: return Type::Boolean;
    }
 }
@@ -136,6 +138,24 @@ QVariant RMT::Input::data(int index, Role role) const
       case Role::Maximum: return std::numeric_limits<int>::max();
       default: return QVariant();
       }
+   case IndexFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("index");
+      case Role::Title: return tr("Threshold Index:");
+      case Role::WhatsThis: return tr("Optional threshold index of the correlation matrix, used to skip blocks without correlations above the stopping threshold.");
+      case Role::FileFilters: return tr("Threshold index file %1").arg("(*.index)");
+      default: return QVariant();
+      }
+   case ProfileFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("profile");
+      case Role::Title: return tr("Profile File:");
+      case Role::WhatsThis: return tr("Optional output file with the sizes and timings of each threshold, written as CSV if the file name ends in .csv and as JSON otherwise.");
+      case Role::FileFilters: return tr("Profile file %1").arg("(*.json *.csv)");
+      default: return QVariant();
+      }
    default: return QVariant();
    }
 }
@@ -181,6 +201,14 @@ void RMT::Input::set(int index, QFile* file)
    {
       _base->_logfile = file;
    }
+   else if ( index == IndexFile )
+   {
+      _base->_index = file;
+   }
+   else if ( index == ProfileFile )
+   {
+      _base->_profileFile = file;
+   }
 }
 
 
@@ -18,6 +18,8 @@ public:
       ,MinUnfoldingPace
       ,MaxUnfoldingPace
       ,HistogramBinSize
+      ,IndexFile
+      ,ProfileFile
       ,Total
    };
    explicit Input(RMT* parent);
@@ -1,7 +1,10 @@
 #include "similarity.h"
+#include "similarity_checkpoint.h"
 #include "similarity_input.h"
+#include "similarity_pairset.h"
 #include "similarity_resultblock.h"
 #include "similarity_serial.h"
+#include "similarity_statistics.h"
 #include "similarity_workblock.h"
 #include "similarity_opencl.h"
 
@@ -14,12 +17,24 @@ using namespace std;
 
 
 
+Similarity::Similarity() = default;
+
+
+
+
+
+
+Similarity::~Similarity() = default;
+
+
+
+
+
+
 int Similarity::size() const
 {
-   const qint64 totalPairs {(qint64) _input->getGeneSize() * (_input->getGeneSize() - 1) / 2};
-   const qint64 WORK_BLOCK_SIZE { 32 * 1024 };
-
-   return (totalPairs + WORK_BLOCK_SIZE - 1) / WORK_BLOCK_SIZE;
+   // work blocks committed by the checkpoint this run resumed from are skipped
+   return shardBlock(_shardIndex + 1) - shardBlock(_shardIndex) - _committedBlocks;
 }
 
 
@@ -29,12 +44,19 @@ int Similarity::size() const
 
 std::unique_ptr<EAbstractAnalytic::Block> Similarity::makeWork(int index) const
 {
-   const qint64 totalPairs {(qint64) _input->getGeneSize() * (_input->getGeneSize() - 1) / 2};
+   const qint64 totalPairs {pairSize()};
    const qint64 WORK_BLOCK_SIZE { 32 * 1024 };
 
-   qint64 start {index * WORK_BLOCK_SIZE};
+   qint64 start {(shardBlock(_shardIndex) + _committedBlocks + index) * WORK_BLOCK_SIZE};
    qint64 size {min(totalPairs - start, WORK_BLOCK_SIZE)};
 
+   // work blocks over a subset of pairs carry the indexes of their pairs, since workers
+   // do not have the pair set
+   if ( _pairSet )
+   {
+      return unique_ptr<EAbstractAnalytic::Block>(new WorkBlock(index, start, size, _pairSet->indices(start, size)));
+   }
+
    return unique_ptr<EAbstractAnalytic::Block>(new WorkBlock(index, start, size));
 }
 
@@ -67,15 +89,44 @@ void Similarity::process(const EAbstractAnalytic::Block* result)
 {
    const ResultBlock* resultBlock {result->cast<ResultBlock>()};
 
-   // iterate through all pairs in result block
+   QElapsedTimer timer;
+   timer.start();
+
+   // add statistics of the worker which computed the block
+   const Statistics& workerStatistics {resultBlock->statistics()};
+
+   _statistics[workerStatistics.worker].add(workerStatistics);
+
+   // statistics of writing results, which are kept separate from the workers
+   Statistics& statistics {_statistics["master"]};
+
+   // write to the current checkpoint segment if checkpoints are enabled
+   CCMatrix* ccm {_checkpoint ? _checkpoint->ccm() : _ccm};
+   CorrelationMatrix* cmx {_checkpoint ? _checkpoint->cmx() : _cmx};
+
+   // iterate through all pairs in result block, which are either consecutive pairs or
+   // the pairs of the pair set starting at the start of the block
+   QVector<Pairwise::PackedIndex> indices;
+
+   if ( _pairSet )
+   {
+      indices = _pairSet->indices(resultBlock->start(), resultBlock->pairs().size());
+   }
+
    Pairwise::Index index {resultBlock->start()};
+   int indexPos {0};
 
    for ( auto& pair : resultBlock->pairs() )
    {
+      if ( _pairSet )
+      {
+         index = Pairwise::Index::unpack(indices.at(indexPos++));
+      }
+
       // save clusters whose correlations are within thresholds
       if ( pair.K > 1 )
       {
-         CCMatrix::Pair ccmPair(_ccm);
+         CCMatrix::Pair ccmPair(ccm);
 
          for ( qint8 k = 0; k < pair.K; ++k )
          {
@@ -97,13 +148,14 @@ void Similarity::process(const EAbstractAnalytic::Block* result)
          if ( ccmPair.clusterSize() > 0 )
          {
             ccmPair.write(index);
+            statistics.bytesWritten += (qint64)ccmPair.clusterSize() * ccm->itemSize();
          }
       }
 
       // save correlations that are within thresholds
       if ( pair.K > 0 )
       {
-         CorrelationMatrix::Pair cmxPair(_cmx);
+         CorrelationMatrix::Pair cmxPair(cmx);
 
          for ( qint8 k = 0; k < pair.K; ++k )
          {
@@ -119,11 +171,53 @@ void Similarity::process(const EAbstractAnalytic::Block* result)
          if ( cmxPair.clusterSize() > 0 )
          {
             cmxPair.write(index);
+            statistics.bytesWritten += (qint64)cmxPair.clusterSize() * cmx->itemSize();
          }
       }
 
       ++index;
    }
+
+   // commit checkpoint segment at every interval and at the last work block, once the
+   // last work block is committed append all segments to the output matrices
+   if ( _checkpoint )
+   {
+      int blocks {resultBlock->index() + 1};
+
+      if ( blocks % _checkpointInterval == 0 || blocks == size() )
+      {
+         _checkpoint->commit(_committedBlocks + blocks);
+
+         if ( blocks == size() )
+         {
+            _checkpoint->merge();
+         }
+      }
+   }
+
+   statistics.blocks += 1;
+   statistics.times[Statistics::Process] += timer.nsecsElapsed();
+
+   // report progress at every interval
+   ++_processedBlocks;
+
+   if ( _progressInterval > 0 && _processedBlocks % _progressInterval == 0 )
+   {
+      qint64 pairs {0};
+      for ( const Statistics& workerStatistics : _statistics )
+      {
+         pairs += workerStatistics.pairs;
+      }
+
+      qInfo("similarity: %d of %d blocks, %lld pairs, %.0f pairs/s",
+            _processedBlocks, size(), pairs, pairs / (_timer.nsecsElapsed() / 1e9));
+   }
+
+   // write statistics once the last block is processed
+   if ( _processedBlocks == size() && _statisticsFile )
+   {
+      writeStatistics();
+   }
 }
 
 
@@ -186,6 +280,27 @@ void Similarity::initialize()
       throw e;
    }
 
+   // make sure shard is valid
+   if ( _shardIndex >= _shardCount )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Shard index must be less than the number of shards."));
+      throw e;
+   }
+
+   // make sure pairs are given either by gene, by pair or by a previous run
+   if ( (_geneFile != nullptr) + (_pairFile != nullptr) + (_previousCcm != nullptr || _previousCmx != nullptr) > 1 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Only one of a gene list, a pair list or a previous run can be given."));
+      throw e;
+   }
+
+   // initialize the subset of pairs to compute, if any
+   initializePairs();
+
    // initialize cluster matrix
    _ccm->initialize(_input->getGeneNames(), _maxClusters, _input->getSampleNames());
 
@@ -194,4 +309,279 @@ void Similarity::initialize()
    correlations.append(_corrModel->getName());
 
    _cmx->initialize(_input->getGeneNames(), _maxClusters, correlations);
+
+   // copy the pairs of a previous run, which come before all computed pairs
+   initializePrevious();
+
+   // start timing the run for statistics and progress
+   _timer.start();
+
+   // initialize checkpoint, resuming from an existing checkpoint if requested
+   if ( !_checkpointPath.isEmpty() )
+   {
+      _checkpoint = new Checkpoint(this, _checkpointPath);
+
+      if ( _resume )
+      {
+         _checkpoint->load();
+         _committedBlocks = _checkpoint->blocks();
+
+         // if every work block was already committed only the output remains
+         if ( size() == 0 )
+         {
+            _checkpoint->merge();
+         }
+      }
+   }
+}
+
+
+
+
+
+
+qint64 Similarity::pairSize() const
+{
+   if ( _pairSet )
+   {
+      return _pairSet->size();
+   }
+
+   return (qint64) _input->getGeneSize() * (_input->getGeneSize() - 1) / 2;
+}
+
+
+
+
+
+
+qint64 Similarity::shardBlock(int shard) const
+{
+   const qint64 totalPairs {pairSize()};
+   const qint64 WORK_BLOCK_SIZE { 32 * 1024 };
+   const qint64 totalBlocks {(totalPairs + WORK_BLOCK_SIZE - 1) / WORK_BLOCK_SIZE};
+
+   // each shard is a contiguous range of work blocks so the pairs of all shards in order
+   // are the pairs of an entire run in order
+   return totalBlocks * shard / _shardCount;
+}
+
+
+
+
+
+
+void Similarity::initializePairs()
+{
+   const int geneSize {_input->getGeneSize()};
+
+   // compute the pairs of the listed genes with all genes or with each other
+   if ( _geneFile )
+   {
+      _pairSet.reset(new PairSet(geneSize, readGenes(_geneFile, 1), !_geneSubsetOnly));
+   }
+
+   // compute only the listed pairs, in either order of their genes
+   else if ( _pairFile )
+   {
+      QVector<qint32> genes {readGenes(_pairFile, 2)};
+      QVector<Pairwise::PackedIndex> pairs;
+
+      for ( int i = 0; i < genes.size(); i += 2 )
+      {
+         qint32 x {max(genes.at(i), genes.at(i + 1))};
+         qint32 y {min(genes.at(i), genes.at(i + 1))};
+
+         // make sure pair is not a gene with itself
+         if ( x == y )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Invalid Argument"));
+            e.setDetails(tr("Pair list contains a pair of gene %1 with itself.")
+                         .arg(_input->getGeneNames().toArray().at(x).toString()));
+            throw e;
+         }
+
+         pairs.append(Pairwise::Index(x, y).pack());
+      }
+
+      _pairSet.reset(new PairSet(pairs));
+   }
+
+   // compute only the pairs of the genes appended since a previous run, which are the
+   // pairs of those genes with all genes
+   else if ( _previousCcm || _previousCmx )
+   {
+      QVector<qint32> genes;
+
+      for ( int i = _previousCmx ? _previousCmx->geneSize() : 0; i < geneSize; ++i )
+      {
+         genes.append(i);
+      }
+
+      _pairSet.reset(new PairSet(geneSize, genes, true));
+   }
+}
+
+
+
+
+
+
+void Similarity::initializePrevious()
+{
+   if ( !_previousCcm && !_previousCmx )
+   {
+      return;
+   }
+
+   // make sure both matrices of the previous run are given
+   if ( !_previousCcm || !_previousCmx || _previousCcm->geneSize() != _previousCmx->geneSize() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("The cluster and correlation matrices of the same previous run must be given."));
+      throw e;
+   }
+
+   // make sure the genes of the previous run are the first genes of the input
+   const EMetaArray geneNames {_input->getGeneNames().toArray()};
+   const EMetaArray previousGeneNames {_previousCmx->geneNames().toArray()};
+   bool isPrefix {previousGeneNames.size() <= geneNames.size()};
+
+   for ( int i = 0; isPrefix && i < previousGeneNames.size(); ++i )
+   {
+      isPrefix = (previousGeneNames.at(i).toString() == geneNames.at(i).toString());
+   }
+
+   if ( !isPrefix )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("The genes of the previous run must be the first genes of the input, in the same order."));
+      throw e;
+   }
+
+   // make sure the previous run has the same samples and correlation and no more clusters
+   const EMetaArray sampleNames {_input->getSampleNames().toArray()};
+   const EMetaArray previousSampleNames {_previousCcm->sampleNames().toArray()};
+   bool isSameSamples {previousSampleNames.size() == sampleNames.size()};
+
+   for ( int i = 0; isSameSamples && i < sampleNames.size(); ++i )
+   {
+      isSameSamples = (previousSampleNames.at(i).toString() == sampleNames.at(i).toString());
+   }
+
+   if ( !isSameSamples
+        || _previousCmx->correlationNames().toArray().at(0).toString() != _corrModel->getName()
+        || _previousCcm->maxClusterSize() > _maxClusters
+        || _previousCmx->maxClusterSize() > _maxClusters )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("The previous run must have the same samples and correlation method and no "
+                      "more clusters than this run."));
+      throw e;
+   }
+
+   // copy the pairs of the previous run, which are all before the pairs of the appended
+   // genes, only the first shard has them so that merged shards have them once
+   if ( _shardIndex == 0 )
+   {
+      _ccm->append(_previousCcm);
+      _cmx->append(_previousCmx);
+   }
+}
+
+
+
+
+
+
+QVector<qint32> Similarity::readGenes(QFile* file, int namesPerLine) const
+{
+   // build lookup table of gene names
+   const EMetaArray geneNames {_input->getGeneNames().toArray()};
+   QHash<QString, qint32> lookup;
+
+   for ( int i = 0; i < geneNames.size(); ++i )
+   {
+      lookup.insert(geneNames.at(i).toString(), i);
+   }
+
+   // read the genes of every line that is not empty
+   QTextStream stream(file);
+   QVector<qint32> genes;
+
+   while ( !stream.atEnd() )
+   {
+      QStringList names {stream.readLine().split(QRegExp("\\s+"), QString::SkipEmptyParts)};
+
+      if ( names.isEmpty() )
+      {
+         continue;
+      }
+
+      // make sure line has the expected number of names
+      if ( names.size() != namesPerLine )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Invalid Argument"));
+         e.setDetails(tr("Expected %1 gene names per line in %2.").arg(namesPerLine).arg(file->fileName()));
+         throw e;
+      }
+
+      for ( auto& name : names )
+      {
+         // make sure gene is in the expression matrix
+         if ( !lookup.contains(name) )
+         {
+            E_MAKE_EXCEPTION(e);
+            e.setTitle(tr("Invalid Argument"));
+            e.setDetails(tr("Gene %1 in %2 is not in the expression matrix.").arg(name).arg(file->fileName()));
+            throw e;
+         }
+
+         genes.append(lookup.value(name));
+      }
+   }
+
+   return genes;
+}
+
+
+
+
+
+
+void Similarity::writeStatistics()
+{
+   // sum the statistics of every worker and the master
+   Statistics total;
+   QJsonObject workers;
+
+   for ( auto it = _statistics.constBegin(); it != _statistics.constEnd(); ++it )
+   {
+      total.add(it.value());
+      workers.insert(it.key(), it.value().toJson());
+   }
+
+   total.blocks = _processedBlocks;
+
+   double seconds {_timer.nsecsElapsed() / 1e9};
+
+   QJsonObject root;
+   root.insert("seconds", seconds);
+   root.insert("pairsPerSecond", total.pairs / seconds);
+   root.insert("total", total.toJson());
+   root.insert("workers", workers);
+
+   // make sure writing statistics file worked
+   if ( _statisticsFile->write(QJsonDocument(root).toJson()) == -1 )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Failed writing statistics file: %1").arg(_statisticsFile->errorString()));
+      throw e;
+   }
 }
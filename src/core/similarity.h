@@ -23,11 +23,16 @@ public:
       QVector<float> correlations;
    };
 
+   class Checkpoint;
    class Input;
+   class PairSet;
    class WorkBlock;
    class ResultBlock;
    class Serial;
+   class Statistics;
    class OpenCL;
+   Similarity();
+   ~Similarity();
    virtual int size() const override final;
    virtual std::unique_ptr<EAbstractAnalytic::Block> makeWork(int index) const override final;
    virtual std::unique_ptr<EAbstractAnalytic::Block> makeWork() const override final;
@@ -52,6 +57,12 @@ private:
       ,Spearman
    };
 
+   qint64 pairSize() const;
+   qint64 shardBlock(int shard) const;
+   void initializePairs();
+   void initializePrevious();
+   QVector<qint32> readGenes(QFile* file, int namesPerLine) const;
+   void writeStatistics();
    ExpressionMatrix* _input {nullptr};
    CCMatrix* _ccm {nullptr};
    CorrelationMatrix* _cmx {nullptr};
@@ -69,6 +80,26 @@ private:
    float _minCorrelation {0.5};
    float _maxCorrelation {1.0};
    int _kernelSize {4096};
+   QFile* _geneFile {nullptr};
+   bool _geneSubsetOnly {false};
+   QFile* _pairFile {nullptr};
+   // pairs of a run over a subset of pairs, or null if the run is over all pairs
+   std::unique_ptr<PairSet> _pairSet;
+   CCMatrix* _previousCcm {nullptr};
+   CorrelationMatrix* _previousCmx {nullptr};
+   int _shardIndex {0};
+   int _shardCount {1};
+   QString _checkpointPath;
+   int _checkpointInterval {64};
+   bool _resume {false};
+   Checkpoint* _checkpoint {nullptr};
+   int _committedBlocks {0};
+   QFile* _statisticsFile {nullptr};
+   int _progressInterval {0};
+   int _processedBlocks {0};
+   QElapsedTimer _timer;
+   // statistics received from each worker, keyed by worker name
+   QMap<QString, Statistics> _statistics;
 };
 
 
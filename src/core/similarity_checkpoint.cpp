@@ -0,0 +1,251 @@
+#include "similarity_checkpoint.h"
+#include "datafactory.h"
+
+
+
+using namespace std;
+
+
+
+
+
+
+Similarity::Checkpoint::Checkpoint(Similarity* parent, const QString& path):
+   QObject(parent),
+   _base(parent),
+   _path(path)
+{
+}
+
+
+
+
+
+
+void Similarity::Checkpoint::load()
+{
+   // if there is no checkpoint file then start from the beginning
+   QFile file(_path + ".checkpoint");
+   if ( !file.exists() )
+   {
+      return;
+   }
+
+   // read checkpoint file
+   if ( !file.open(QIODevice::ReadOnly) )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Could not open checkpoint file %1.").arg(file.fileName()));
+      throw e;
+   }
+
+   QJsonObject root {QJsonDocument::fromJson(file.readAll()).object()};
+
+   // make sure checkpoint was made by a run over the same input and shard
+   if ( root.value("genes").toInt(-1) != _base->_input->getGeneSize()
+        || root.value("clusters").toInt(-1) != _base->_maxClusters
+        || root.value("shard").toInt(-1) != _base->_shardIndex
+        || root.value("shards").toInt(-1) != _base->_shardCount
+        || (root.contains("pairs") && (qint64)root.value("pairs").toDouble() != _base->pairSize()) )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Checkpoint Error"));
+      e.setDetails(tr("Checkpoint file %1 does not match the input and arguments of this run.")
+                   .arg(file.fileName()));
+      throw e;
+   }
+
+   // read each committed segment making sure its data objects are intact
+   for ( const auto& value : root.value("segments").toArray() )
+   {
+      QJsonObject object {value.toObject()};
+      Segment segment {
+         (qint64)object.value("ccmPairs").toDouble(),
+         (qint64)object.value("ccmClusters").toDouble(),
+         (qint64)object.value("cmxPairs").toDouble(),
+         (qint64)object.value("cmxClusters").toDouble()
+      };
+
+      Ace::DataObject ccmData(segmentPath(_segments.size(), "ccm"));
+      Ace::DataObject cmxData(segmentPath(_segments.size(), "cmx"));
+      const CCMatrix* ccm {ccmData.data()->cast<CCMatrix>()};
+      const CorrelationMatrix* cmx {cmxData.data()->cast<CorrelationMatrix>()};
+
+      if ( ccm->size() != segment.ccmPairs
+           || ccm->clusterSize() != segment.ccmClusters
+           || cmx->size() != segment.cmxPairs
+           || cmx->clusterSize() != segment.cmxClusters )
+      {
+         E_MAKE_EXCEPTION(e);
+         e.setTitle(tr("Checkpoint Error"));
+         e.setDetails(tr("Checkpoint segment %1 does not match the sizes recorded in %2.")
+                      .arg(_segments.size())
+                      .arg(file.fileName()));
+         throw e;
+      }
+
+      _segments.append(segment);
+   }
+
+   // resume after the last committed work block
+   _blocks = root.value("blocks").toInt();
+}
+
+
+
+
+
+
+CCMatrix* Similarity::Checkpoint::ccm()
+{
+   begin();
+   return _ccm;
+}
+
+
+
+
+
+
+CorrelationMatrix* Similarity::Checkpoint::cmx()
+{
+   begin();
+   return _cmx;
+}
+
+
+
+
+
+
+void Similarity::Checkpoint::commit(int blocks)
+{
+   // finalize current segment if one was started and add it to the committed segments
+   if ( _ccmData )
+   {
+      _ccmData->data()->finish();
+      _ccmData->finalize();
+      _cmxData->data()->finish();
+      _cmxData->finalize();
+
+      _segments.append({ _ccm->size(), _ccm->clusterSize(), _cmx->size(), _cmx->clusterSize() });
+
+      _ccmData.reset();
+      _cmxData.reset();
+      _ccm = nullptr;
+      _cmx = nullptr;
+   }
+
+   // record all work blocks as committed only after their segment is finalized
+   _blocks = blocks;
+   save();
+}
+
+
+
+
+
+
+void Similarity::Checkpoint::merge()
+{
+   // append each committed segment in order to the output matrices
+   for ( int i = 0; i < _segments.size(); ++i )
+   {
+      Ace::DataObject ccmData(segmentPath(i, "ccm"));
+      Ace::DataObject cmxData(segmentPath(i, "cmx"));
+
+      _base->_ccm->append(ccmData.data()->cast<CCMatrix>());
+      _base->_cmx->append(cmxData.data()->cast<CorrelationMatrix>());
+   }
+
+   // remove the segments and the checkpoint, which are no longer needed once every
+   // segment is in the output matrices
+   for ( int i = 0; i < _segments.size(); ++i )
+   {
+      QFile::remove(segmentPath(i, "ccm"));
+      QFile::remove(segmentPath(i, "cmx"));
+   }
+
+   QFile::remove(_path + ".checkpoint");
+}
+
+
+
+
+
+
+void Similarity::Checkpoint::begin()
+{
+   // if a segment is already started do nothing
+   if ( _ccmData )
+   {
+      return;
+   }
+
+   // create new segment data objects, replacing any left by a run that did not commit them
+   QString ccmPath {segmentPath(_segments.size(), "ccm")};
+   QString cmxPath {segmentPath(_segments.size(), "cmx")};
+   QFile::remove(ccmPath);
+   QFile::remove(cmxPath);
+
+   _ccmData.reset(new Ace::DataObject(ccmPath, DataFactory::CCMatrixType, EMetadata(EMetadata::Object)));
+   _cmxData.reset(new Ace::DataObject(cmxPath, DataFactory::CorrelationMatrixType, EMetadata(EMetadata::Object)));
+   _ccm = _ccmData->data()->cast<CCMatrix>();
+   _cmx = _cmxData->data()->cast<CorrelationMatrix>();
+
+   // initialize segments the same way as the output matrices
+   _ccm->initialize(_base->_ccm->geneNames(), _base->_ccm->maxClusterSize(), _base->_ccm->sampleNames());
+   _cmx->initialize(_base->_cmx->geneNames(), _base->_cmx->maxClusterSize(), _base->_cmx->correlationNames());
+}
+
+
+
+
+
+
+void Similarity::Checkpoint::save() const
+{
+   // build checkpoint object
+   QJsonArray segments;
+   for ( const auto& segment : _segments )
+   {
+      QJsonObject object;
+      object.insert("ccmPairs", (double)segment.ccmPairs);
+      object.insert("ccmClusters", (double)segment.ccmClusters);
+      object.insert("cmxPairs", (double)segment.cmxPairs);
+      object.insert("cmxClusters", (double)segment.cmxClusters);
+      segments.append(object);
+   }
+
+   QJsonObject root;
+   root.insert("genes", _base->_input->getGeneSize());
+   root.insert("clusters", _base->_maxClusters);
+   root.insert("shard", _base->_shardIndex);
+   root.insert("shards", _base->_shardCount);
+   root.insert("pairs", (double)_base->pairSize());
+   root.insert("blocks", _blocks);
+   root.insert("segments", segments);
+
+   // replace checkpoint file atomically so a failure never leaves a partial checkpoint
+   QSaveFile file(_path + ".checkpoint");
+   if ( !file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(root).toJson()) == -1
+        || !file.commit() )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("File IO Error"));
+      e.setDetails(tr("Could not write checkpoint file %1.").arg(file.fileName()));
+      throw e;
+   }
+}
+
+
+
+
+
+
+QString Similarity::Checkpoint::segmentPath(int segment, const QString& extension) const
+{
+   return QString("%1.%2.%3").arg(_path).arg(segment).arg(extension);
+}
@@ -0,0 +1,44 @@
+#ifndef SIMILARITY_CHECKPOINT_H
+#define SIMILARITY_CHECKPOINT_H
+#include <ace/core/ace_dataobject.h>
+
+#include "similarity.h"
+
+
+
+class Similarity::Checkpoint : public QObject
+{
+   Q_OBJECT
+public:
+   explicit Checkpoint(Similarity* parent, const QString& path);
+   int blocks() const { return _blocks; }
+   void load();
+   CCMatrix* ccm();
+   CorrelationMatrix* cmx();
+   void commit(int blocks);
+   void merge();
+private:
+   struct Segment
+   {
+      qint64 ccmPairs;
+      qint64 ccmClusters;
+      qint64 cmxPairs;
+      qint64 cmxClusters;
+   };
+   void begin();
+   void save() const;
+   QString segmentPath(int segment, const QString& extension) const;
+
+   Similarity* _base;
+   QString _path;
+   int _blocks {0};
+   QVector<Segment> _segments;
+   std::unique_ptr<Ace::DataObject> _ccmData;
+   std::unique_ptr<Ace::DataObject> _cmxData;
+   CCMatrix* _ccm {nullptr};
+   CorrelationMatrix* _cmx {nullptr};
+};
+
+
+
+#endif
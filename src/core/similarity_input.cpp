@@ -44,6 +44,17 @@ const QStringList Similarity::Input::CRITERION_NAMES
 
 
 
+const QStringList Similarity::Input::GENE_PAIRS_NAMES
+{
+   "all"
+   ,"subset"
+};
+
+
+
+
+
+
 Similarity::Input::Input(Similarity* parent):
    EAbstractAnalytic::Input(parent),
    _base(parent)
@@ -84,6 +95,18 @@ EAbstractAnalytic::Input::Type Similarity::Input::type(int index) const
    case MinCorrelation: return Type::Double;
    case MaxCorrelation: return Type::Double;
    case KernelSize: return Type::Integer;
+   case GeneFile: return Type::FileIn;
+   case GenePairs: return Type::Selection;
+   case PairFile: return Type::FileIn;
+   case PreviousClusterData: return Type::DataIn;
+   case PreviousCorrelationData: return Type::DataIn;
+   case ShardIndex: return Type::Integer;
+   case ShardCount: return Type::Integer;
+   case CheckpointPath: return Type::String;
+   case CheckpointInterval: return Type::Integer;
+   case Resume: return Type::Boolean;
+   case StatisticsFile: return Type::FileOut;
+   case ProgressInterval: return Type::Integer;
    default: return Type::Boolean;
    }
 }
@@ -249,6 +272,123 @@ QVariant Similarity::Input::data(int index, Role role) const
       case Role::Maximum: return std::numeric_limits<int>::max();
       default: return QVariant();
       }
+   case GeneFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("genes");
+      case Role::Title: return tr("Gene List:");
+      case Role::WhatsThis: return tr("Optional text file with one gene name per line, whose pairs are computed instead of all pairs.");
+      case Role::FileFilters: return tr("Text file %1").arg("(*.txt)");
+      default: return QVariant();
+      }
+   case GenePairs:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("gene-pairs");
+      case Role::Title: return tr("Gene List Pairs:");
+      case Role::WhatsThis: return tr("Whether to compute the pairs of the listed genes with all genes or only with each other.");
+      case Role::SelectionValues: return GENE_PAIRS_NAMES;
+      case Role::Default: return "all";
+      default: return QVariant();
+      }
+   case PairFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("pairs");
+      case Role::Title: return tr("Pair List:");
+      case Role::WhatsThis: return tr("Optional text file with two gene names per line, whose pairs are computed instead of all pairs.");
+      case Role::FileFilters: return tr("Text file %1").arg("(*.txt)");
+      default: return QVariant();
+      }
+   case PreviousClusterData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("prev-ccm");
+      case Role::Title: return tr("Previous Cluster Matrix:");
+      case Role::WhatsThis: return tr("Optional cluster matrix of a previous run over the first genes of the input, whose pairs are copied instead of computed.");
+      case Role::DataType: return DataFactory::CCMatrixType;
+      default: return QVariant();
+      }
+   case PreviousCorrelationData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("prev-cmx");
+      case Role::Title: return tr("Previous Correlation Matrix:");
+      case Role::WhatsThis: return tr("Optional correlation matrix of a previous run over the first genes of the input, whose pairs are copied instead of computed.");
+      case Role::DataType: return DataFactory::CorrelationMatrixType;
+      default: return QVariant();
+      }
+   case ShardIndex:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("shard");
+      case Role::Title: return tr("Shard Index:");
+      case Role::WhatsThis: return tr("Index of the contiguous range of gene pairs to process when the run is split into shards.");
+      case Role::Default: return 0;
+      case Role::Minimum: return 0;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
+   case ShardCount:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("shards");
+      case Role::Title: return tr("Shard Count:");
+      case Role::WhatsThis: return tr("Number of shards the run is split into, shard outputs are combined with merge-similarity.");
+      case Role::Default: return 1;
+      case Role::Minimum: return 1;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
+   case CheckpointPath:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("checkpoint");
+      case Role::Title: return tr("Checkpoint Path:");
+      case Role::WhatsThis: return tr("Path prefix of checkpoint files. If given, results are committed in segments so an interrupted run can be resumed.");
+      case Role::Default: return QString();
+      default: return QVariant();
+      }
+   case CheckpointInterval:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("checkpoint-interval");
+      case Role::Title: return tr("Checkpoint Interval:");
+      case Role::WhatsThis: return tr("Number of work blocks to process between checkpoints.");
+      case Role::Default: return 64;
+      case Role::Minimum: return 1;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
+   case Resume:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("resume");
+      case Role::Title: return tr("Resume:");
+      case Role::WhatsThis: return tr("Whether to resume from the last checkpoint instead of starting over.");
+      case Role::Default: return false;
+      default: return QVariant();
+      }
+   case StatisticsFile:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("stats");
+      case Role::Title: return tr("Statistics File:");
+      case Role::WhatsThis: return tr("Optional output file that will contain a JSON summary of the time spent in each stage and pair counts of every worker.");
+      case Role::FileFilters: return tr("JSON file %1").arg("(*.json)");
+      default: return QVariant();
+      }
+   case ProgressInterval:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("progress");
+      case Role::Title: return tr("Progress Interval:");
+      case Role::WhatsThis: return tr("Number of work blocks between progress lines, or 0 to disable progress lines.");
+      case Role::Default: return 0;
+      case Role::Minimum: return 0;
+      case Role::Maximum: return std::numeric_limits<int>::max();
+      default: return QVariant();
+      }
    default: return QVariant();
    }
 }
@@ -321,6 +461,27 @@ void Similarity::Input::set(int index, const QVariant& value)
    case KernelSize:
       _base->_kernelSize = value.toInt();
       break;
+   case GenePairs:
+      _base->_geneSubsetOnly = (value.toString() == "subset");
+      break;
+   case ShardIndex:
+      _base->_shardIndex = value.toInt();
+      break;
+   case ShardCount:
+      _base->_shardCount = value.toInt();
+      break;
+   case CheckpointPath:
+      _base->_checkpointPath = value.toString();
+      break;
+   case CheckpointInterval:
+      _base->_checkpointInterval = value.toInt();
+      break;
+   case Resume:
+      _base->_resume = value.toBool();
+      break;
+   case ProgressInterval:
+      _base->_progressInterval = value.toInt();
+      break;
    }
 }
 
@@ -331,8 +492,18 @@ void Similarity::Input::set(int index, const QVariant& value)
 
 void Similarity::Input::set(int index, QFile* file)
 {
-   Q_UNUSED(index)
-   Q_UNUSED(file)
+   if ( index == StatisticsFile )
+   {
+      _base->_statisticsFile = file;
+   }
+   else if ( index == GeneFile )
+   {
+      _base->_geneFile = file;
+   }
+   else if ( index == PairFile )
+   {
+      _base->_pairFile = file;
+   }
 }
 
 
@@ -353,5 +524,11 @@ void Similarity::Input::set(int index, EAbstractData *data)
    case CorrelationData:
       _base->_cmx = data->cast<CorrelationMatrix>();
       break;
+   case PreviousClusterData:
+      _base->_previousCcm = data->cast<CCMatrix>();
+      break;
+   case PreviousCorrelationData:
+      _base->_previousCmx = data->cast<CorrelationMatrix>();
+      break;
    }
 }
@@ -25,6 +25,18 @@ public:
       ,MinCorrelation
       ,MaxCorrelation
       ,KernelSize
+      ,GeneFile
+      ,GenePairs
+      ,PairFile
+      ,PreviousClusterData
+      ,PreviousCorrelationData
+      ,ShardIndex
+      ,ShardCount
+      ,CheckpointPath
+      ,CheckpointInterval
+      ,Resume
+      ,StatisticsFile
+      ,ProgressInterval
       ,Total
    };
    explicit Input(Similarity* parent);
@@ -39,6 +51,7 @@ private:
    static const QStringList CLUSTERING_NAMES;
    static const QStringList CORRELATION_NAMES;
    static const QStringList CRITERION_NAMES;
+   static const QStringList GENE_PAIRS_NAMES;
 
    Similarity* _base;
 };
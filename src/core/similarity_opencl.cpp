@@ -52,18 +52,39 @@ void Similarity::OpenCL::initialize(::OpenCL::Context* context)
    // create command queue
    _queue = new ::OpenCL::CommandQueue(context, context->devices().first(), this);
 
-   // create buffer for expression data
-   _expressions = ::OpenCL::Buffer<cl_float>(context, _base->_input->getRawSize());
+   // create buffer for expression data, where float16 matrices are copied as they are
+   // stored and are converted by the fetch-pair kernel, which halves device memory
+   qint64 rawSize {_base->_input->getRawSize()};
 
-   unique_ptr<ExpressionMatrix::Expression> rawData(_base->_input->dumpRawData());
-   ExpressionMatrix::Expression* rawDataRef {rawData.get()};
+   if ( _base->_input->getStorage() == ExpressionMatrix::Storage::Float16 )
+   {
+      _expressions = ::OpenCL::Buffer<cl_float>(context, (rawSize + 1) / 2);
+
+      QVector<quint16> halves(2 * ((rawSize + 1) / 2));
+      _base->_input->readHalfGenes(0, _base->_input->getGeneSize(), halves.data());
 
-   // copy expression data to device
-   _expressions.mapWrite(_queue).wait();
+      // copy expression data to device, two halves per element
+      _expressions.mapWrite(_queue).wait();
 
-   for ( int i = 0; i < _base->_input->getRawSize(); ++i )
+      for ( int i = 0; i < halves.size() / 2; ++i )
+      {
+         memcpy(&_expressions[i], &halves[2 * i], sizeof(cl_float));
+      }
+   }
+   else
    {
-      _expressions[i] = rawDataRef[i];
+      _expressions = ::OpenCL::Buffer<cl_float>(context, rawSize);
+
+      unique_ptr<ExpressionMatrix::Expression> rawData(_base->_input->dumpRawData());
+      ExpressionMatrix::Expression* rawDataRef {rawData.get()};
+
+      // copy expression data to device
+      _expressions.mapWrite(_queue).wait();
+
+      for ( int i = 0; i < rawSize; ++i )
+      {
+         _expressions[i] = rawDataRef[i];
+      }
    }
 
    _expressions.unmap(_queue).wait();
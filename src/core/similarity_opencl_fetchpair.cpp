@@ -23,8 +23,9 @@ Similarity::OpenCL::FetchPair::FetchPair(::OpenCL::Program* program, QObject* pa
    ::OpenCL::CommandQueue* queue,
    int kernelSize,
    ::OpenCL::Buffer<cl_float>* expressions,
+   cl_int halfPrecision,
    cl_int sampleSize,
-   ::OpenCL::Buffer<cl_int2>* in_index,
+   ::OpenCL::Buffer<cl_long>* in_index,
    cl_int minExpression,
    ::OpenCL::Buffer<Pairwise::Vector2>* out_X,
    ::OpenCL::Buffer<cl_int>* out_N,
@@ -36,6 +37,7 @@ Similarity::OpenCL::FetchPair::FetchPair(::OpenCL::Program* program, QObject* pa
 
    // set kernel arguments
    setBuffer(Expressions, expressions);
+   setArgument(HalfPrecision, halfPrecision);
    setArgument(SampleSize, sampleSize);
    setBuffer(InIndex, in_index);
    setArgument(MinExpression, minExpression);
@@ -11,6 +11,7 @@ public:
    enum Argument
    {
       Expressions
+      ,HalfPrecision
       ,SampleSize
       ,InIndex
       ,MinExpression
@@ -23,8 +24,9 @@ public:
       ::OpenCL::CommandQueue* queue,
       int kernelSize,
       ::OpenCL::Buffer<cl_float>* expressions,
+      cl_int halfPrecision,
       cl_int sampleSize,
-      ::OpenCL::Buffer<cl_int2>* in_index,
+      ::OpenCL::Buffer<cl_long>* in_index,
       cl_int minExpression,
       ::OpenCL::Buffer<Pairwise::Vector2>* out_X,
       ::OpenCL::Buffer<cl_int>* out_N,
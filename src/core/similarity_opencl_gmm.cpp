@@ -40,7 +40,8 @@ Similarity::OpenCL::GMM::GMM(::OpenCL::Program* program, QObject* parent):
    ::OpenCL::Buffer<cl_float>* work_loggamma,
    ::OpenCL::Buffer<cl_float>* work_logGamma,
    ::OpenCL::Buffer<cl_char>* out_K,
-   ::OpenCL::Buffer<cl_char>* out_labels
+   ::OpenCL::Buffer<cl_char>* out_labels,
+   ::OpenCL::Buffer<cl_int>* out_iterations
 )
 {
    // acquire lock for this kernel
@@ -66,6 +67,7 @@ Similarity::OpenCL::GMM::GMM(::OpenCL::Program* program, QObject* parent):
    setBuffer(WorkLogGamma, work_logGamma);
    setBuffer(OutK, out_K);
    setBuffer(OutLabels, out_labels);
+   setBuffer(OutIterations, out_iterations);
 
    // set kernel sizes
    setSizes(0, kernelSize, min(kernelSize, maxWorkGroupSize(queue->device())));
@@ -29,6 +29,7 @@ public:
       ,WorkLogGamma
       ,OutK
       ,OutLabels
+      ,OutIterations
    };
    explicit GMM(::OpenCL::Program* program, QObject* parent = nullptr);
    ::OpenCL::Event execute(
@@ -52,7 +53,8 @@ public:
       ::OpenCL::Buffer<cl_float>* work_loggamma,
       ::OpenCL::Buffer<cl_float>* work_logGamma,
       ::OpenCL::Buffer<cl_char>* out_K,
-      ::OpenCL::Buffer<cl_char>* out_labels
+      ::OpenCL::Buffer<cl_char>* out_labels,
+      ::OpenCL::Buffer<cl_int>* out_iterations
    );
 };
 
@@ -35,7 +35,8 @@ Similarity::OpenCL::KMeans::KMeans(::OpenCL::Program* program, QObject* parent):
    ::OpenCL::Buffer<cl_char>* work_labels,
    ::OpenCL::Buffer<Pairwise::Vector2>* work_means,
    ::OpenCL::Buffer<cl_char>* out_K,
-   ::OpenCL::Buffer<cl_char>* out_labels
+   ::OpenCL::Buffer<cl_char>* out_labels,
+   ::OpenCL::Buffer<cl_int>* out_iterations
 )
 {
    // acquire lock for this kernel
@@ -56,6 +57,7 @@ Similarity::OpenCL::KMeans::KMeans(::OpenCL::Program* program, QObject* parent):
    setBuffer(WorkMeans, work_means);
    setBuffer(OutK, out_K);
    setBuffer(OutLabels, out_labels);
+   setBuffer(OutIterations, out_iterations);
 
    // set kernel sizes
    setSizes(0, kernelSize, min(kernelSize, maxWorkGroupSize(queue->device())));
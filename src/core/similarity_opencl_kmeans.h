@@ -24,6 +24,7 @@ public:
       ,WorkMeans
       ,OutK
       ,OutLabels
+      ,OutIterations
    };
    explicit KMeans(::OpenCL::Program* program, QObject* parent = nullptr);
    ::OpenCL::Event execute(
@@ -42,7 +43,8 @@ public:
       ::OpenCL::Buffer<cl_char>* work_labels,
       ::OpenCL::Buffer<Pairwise::Vector2>* work_means,
       ::OpenCL::Buffer<cl_char>* out_K,
-      ::OpenCL::Buffer<cl_char>* out_labels
+      ::OpenCL::Buffer<cl_char>* out_labels,
+      ::OpenCL::Buffer<cl_int>* out_iterations
    );
 };
 
@@ -65,7 +65,7 @@ Similarity::OpenCL::Worker::Worker(Similarity* base, Similarity::OpenCL* baseOpe
    int N_pow2 {nextPower2(N)};
    int K {_base->_maxClusters};
 
-   _buffers.in_index = ::OpenCL::Buffer<cl_int2>(context, 1 * kernelSize);
+   _buffers.in_index = ::OpenCL::Buffer<cl_long>(context, 1 * kernelSize);
 
    _buffers.work_X = ::OpenCL::Buffer<Pairwise::Vector2>(context, N * kernelSize);
    _buffers.work_N = ::OpenCL::Buffer<cl_int>(context, 1 * kernelSize);
@@ -78,6 +78,7 @@ Similarity::OpenCL::Worker::Worker(Similarity* base, Similarity::OpenCL* baseOpe
    _buffers.work_logGamma = ::OpenCL::Buffer<cl_float>(context, K * kernelSize);
    _buffers.out_K = ::OpenCL::Buffer<cl_char>(context, 1 * kernelSize);
    _buffers.out_labels = ::OpenCL::Buffer<cl_char>(context, N * kernelSize);
+   _buffers.out_iterations = ::OpenCL::Buffer<cl_int>(context, 1 * kernelSize);
 
    _buffers.work_x = ::OpenCL::Buffer<cl_float>(context, N_pow2 * kernelSize);
    _buffers.work_y = ::OpenCL::Buffer<cl_float>(context, N_pow2 * kernelSize);
@@ -98,7 +99,16 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
    // initialize result block
    ResultBlock* resultBlock {new ResultBlock(workBlock->index(), workBlock->start())};
 
-   // iterate through all pairs
+   // initialize statistics, timing each stage of every kernel batch
+   Statistics& statistics {resultBlock->statistics()};
+   statistics.worker = Statistics::workerName();
+   statistics.blocks = 1;
+   statistics.clusterSizes.resize(_base->_maxClusters + 1);
+
+   QElapsedTimer timer;
+   timer.start();
+
+   // iterate through all pairs, which are either consecutive or listed by the block
    Pairwise::Index index {workBlock->start()};
 
    for ( int i = 0; i < workBlock->size(); i += _base->_kernelSize )
@@ -110,22 +120,30 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
 
       for ( int j = 0; j < steps; ++j )
       {
-         _buffers.in_index[j] = { index.getX(), index.getY() };
+         if ( !workBlock->indices().isEmpty() )
+         {
+            index = Pairwise::Index::unpack(workBlock->indices().at(i + j));
+         }
+
+         _buffers.in_index[j] = index.pack();
          ++index;
       }
 
       for ( int j = steps; j < _base->_kernelSize; ++j )
       {
-         _buffers.in_index[j] = { 0, 0 };
+         _buffers.in_index[j] = 0;
       }
 
       _buffers.in_index.unmap(_queue).wait();
 
       // execute fetch-pair kernel
+      qint64 t0 {timer.nsecsElapsed()};
+
       _kernels.fetchPair->execute(
          _queue,
          _base->_kernelSize,
          &_baseOpenCL->_expressions,
+         _base->_input->getStorage() == ExpressionMatrix::Storage::Float16,
          _base->_input->getSampleSize(),
          &_buffers.in_index,
          _base->_minExpression,
@@ -134,6 +152,8 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
          &_buffers.out_labels
       ).wait();
 
+      qint64 t1 {timer.nsecsElapsed()};
+
       // execute clustering kernel
       if ( _base->_clusMethod == ClusteringMethod::GMM )
       {
@@ -158,7 +178,8 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
             &_buffers.work_loggamma,
             &_buffers.work_logGamma,
             &_buffers.out_K,
-            &_buffers.out_labels
+            &_buffers.out_labels,
+            &_buffers.out_iterations
          ).wait();
       }
       else if ( _base->_clusMethod == ClusteringMethod::KMeans )
@@ -179,22 +200,28 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
             &_buffers.work_labels,
             &_buffers.work_MP,
             &_buffers.out_K,
-            &_buffers.out_labels
+            &_buffers.out_labels,
+            &_buffers.out_iterations
          ).wait();
       }
       else
       {
-         // set cluster size to 1 if clustering is disabled
+         // set cluster size to 1 and iterations to 0 if clustering is disabled
          _buffers.out_K.mapWrite(_queue).wait();
+         _buffers.out_iterations.mapWrite(_queue).wait();
 
          for ( int i = 0; i < _base->_kernelSize; ++i )
          {
             _buffers.out_K[i] = 1;
+            _buffers.out_iterations[i] = 0;
          }
 
          _buffers.out_K.unmap(_queue).wait();
+         _buffers.out_iterations.unmap(_queue).wait();
       }
 
+      qint64 t2 {timer.nsecsElapsed()};
+
       // execute correlation kernel
       if ( _base->_corrMethod == CorrelationMethod::Pearson )
       {
@@ -230,10 +257,20 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
       auto e1 {_buffers.out_K.mapRead(_queue)};
       auto e2 {_buffers.out_labels.mapRead(_queue)};
       auto e3 {_buffers.out_correlations.mapRead(_queue)};
+      auto e4 {_buffers.work_N.mapRead(_queue)};
+      auto e5 {_buffers.out_iterations.mapRead(_queue)};
 
       e1.wait();
       e2.wait();
       e3.wait();
+      e4.wait();
+      e5.wait();
+
+      qint64 t3 {timer.nsecsElapsed()};
+
+      statistics.times[Statistics::Fetch] += t1 - t0;
+      statistics.times[Statistics::Clustering] += t2 - t1;
+      statistics.times[Statistics::Correlation] += t3 - t2;
 
       // save results
       for ( int j = 0; j < steps; ++j )
@@ -244,6 +281,11 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
          Pair pair;
          pair.K = _buffers.out_K.at(j);
 
+         statistics.pairs += 1;
+         statistics.skippedPairs += (_buffers.work_N.at(j) < _base->_minSamples);
+         statistics.clusteringIterations += _buffers.out_iterations.at(j);
+         statistics.clusterSizes[pair.K] += 1;
+
          if ( pair.K > 1 )
          {
             pair.labels = createVector(labels, _base->_input->getSampleSize());
@@ -257,15 +299,21 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::OpenCL::Worker::execute(co
          resultBlock->append(pair);
       }
 
-      auto e4 {_buffers.out_K.unmap(_queue)};
-      auto e5 {_buffers.out_labels.unmap(_queue)};
-      auto e6 {_buffers.out_correlations.unmap(_queue)};
+      auto e6 {_buffers.out_K.unmap(_queue)};
+      auto e7 {_buffers.out_labels.unmap(_queue)};
+      auto e8 {_buffers.out_correlations.unmap(_queue)};
+      auto e9 {_buffers.work_N.unmap(_queue)};
+      auto e10 {_buffers.out_iterations.unmap(_queue)};
 
-      e4.wait();
-      e5.wait();
       e6.wait();
+      e7.wait();
+      e8.wait();
+      e9.wait();
+      e10.wait();
    }
 
+   statistics.times[Statistics::Execute] += timer.nsecsElapsed();
+
    // return result block
    return unique_ptr<EAbstractAnalytic::Block>(resultBlock);
 }
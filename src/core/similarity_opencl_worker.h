@@ -27,7 +27,7 @@ private:
    struct
    {
       // input buffers
-      ::OpenCL::Buffer<cl_int2> in_index;
+      ::OpenCL::Buffer<cl_long> in_index;
 
       // clustering buffers
       ::OpenCL::Buffer<Pairwise::Vector2> work_X;
@@ -41,6 +41,7 @@ private:
       ::OpenCL::Buffer<cl_float> work_logGamma;
       ::OpenCL::Buffer<cl_char> out_K;
       ::OpenCL::Buffer<cl_char> out_labels;
+      ::OpenCL::Buffer<cl_int> out_iterations;
 
       // correlation buffers
       ::OpenCL::Buffer<cl_float> work_x;
@@ -0,0 +1,111 @@
+#include <algorithm>
+
+#include "similarity_pairset.h"
+
+
+
+using namespace std;
+
+
+
+
+
+
+Similarity::PairSet::PairSet(int geneSize, const QVector<qint32>& genes, bool withAll):
+   _rowStarts(geneSize + 1, 0),
+   _isGene(geneSize, false),
+   _withAll(withAll)
+{
+   // save sorted genes without duplicates
+   for ( auto gene : genes )
+   {
+      _isGene[gene] = true;
+   }
+
+   for ( int i = 0; i < geneSize; ++i )
+   {
+      if ( _isGene.at(i) )
+      {
+         _genes.append(i);
+      }
+   }
+
+   // count the pairs of each row, which are either the pairs of a listed gene with
+   // every gene before it or the pairs of a gene with the listed genes before it
+   int genesBefore {0};
+
+   for ( int x = 0; x < geneSize; ++x )
+   {
+      qint64 count {0};
+
+      if ( _isGene.at(x) )
+      {
+         count = _withAll ? x : genesBefore;
+         ++genesBefore;
+      }
+      else if ( _withAll )
+      {
+         count = genesBefore;
+      }
+
+      _rowStarts[x + 1] = _rowStarts.at(x) + count;
+   }
+
+   _size = _rowStarts.last();
+}
+
+
+
+
+
+
+Similarity::PairSet::PairSet(const QVector<Pairwise::PackedIndex>& pairs):
+   _pairs(pairs)
+{
+   // sort pairs and remove duplicates, packed indexes sort in the order of pairs
+   std::sort(_pairs.begin(), _pairs.end());
+   _pairs.erase(std::unique(_pairs.begin(), _pairs.end()), _pairs.end());
+
+   _size = _pairs.size();
+}
+
+
+
+
+
+
+QVector<Pairwise::PackedIndex> Similarity::PairSet::indices(qint64 start, qint64 size) const
+{
+   // return the range of pairs given explicitly
+   if ( _rowStarts.isEmpty() )
+   {
+      return _pairs.mid(start, size);
+   }
+
+   // otherwise find the row of the first pair and generate pairs row by row
+   QVector<Pairwise::PackedIndex> indices;
+   indices.reserve(size);
+
+   int x = upper_bound(_rowStarts.begin(), _rowStarts.end(), start) - _rowStarts.begin() - 1;
+   qint64 j {start - _rowStarts.at(x)};
+
+   while ( indices.size() < size && x < _isGene.size() )
+   {
+      // move to the next row at the end of this one
+      if ( j >= _rowStarts.at(x + 1) - _rowStarts.at(x) )
+      {
+         ++x;
+         j = 0;
+         continue;
+      }
+
+      // the pairs of a listed gene with all genes are with every gene before it, any
+      // other row only has pairs with listed genes
+      qint32 y = (_withAll && _isGene.at(x)) ? j : _genes.at(j);
+
+      indices.append(Pairwise::Index(x, y).pack());
+      ++j;
+   }
+
+   return indices;
+}
@@ -0,0 +1,30 @@
+#ifndef SIMILARITY_PAIRSET_H
+#define SIMILARITY_PAIRSET_H
+#include "similarity.h"
+
+
+
+// pairs computed by a run over a subset of all pairs, in the order of their pairwise
+// indexes so that the output matrices are sorted
+class Similarity::PairSet
+{
+public:
+   explicit PairSet(int geneSize, const QVector<qint32>& genes, bool withAll);
+   explicit PairSet(const QVector<Pairwise::PackedIndex>& pairs);
+   qint64 size() const { return _size; }
+   QVector<Pairwise::PackedIndex> indices(qint64 start, qint64 size) const;
+private:
+   qint64 _size {0};
+   // pairs selected by gene are found by row, where _rowStarts[x] is the number of
+   // pairs in the rows before row x
+   QVector<qint64> _rowStarts;
+   QVector<qint32> _genes;
+   QVector<bool> _isGene;
+   bool _withAll {false};
+   // pairs given explicitly
+   QVector<Pairwise::PackedIndex> _pairs;
+};
+
+
+
+#endif
@@ -37,6 +37,8 @@ void Similarity::ResultBlock::write(QDataStream& stream) const
       stream << pair.labels;
       stream << pair.correlations;
    }
+
+   _statistics.write(stream);
 }
 
 
@@ -46,6 +48,9 @@ void Similarity::ResultBlock::write(QDataStream& stream) const
 
 void Similarity::ResultBlock::read(QDataStream& stream)
 {
+   QElapsedTimer timer;
+   timer.start();
+
    stream >> _start;
 
    int size;
@@ -59,4 +64,8 @@ void Similarity::ResultBlock::read(QDataStream& stream)
       stream >> pair.labels;
       stream >> pair.correlations;
    }
+
+   // add the time spent reading the block to the statistics of the worker
+   _statistics.read(stream);
+   _statistics.times[Statistics::Deserialize] += timer.nsecsElapsed();
 }
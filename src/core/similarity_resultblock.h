@@ -1,6 +1,7 @@
 #ifndef SIMILARITY_RESULTBLOCK_H
 #define SIMILARITY_RESULTBLOCK_H
 #include "similarity.h"
+#include "similarity_statistics.h"
 
 
 
@@ -14,12 +15,15 @@ public:
    const QVector<Pair>& pairs() const { return _pairs; }
    QVector<Pair>& pairs() { return _pairs; }
    void append(const Pair& pair);
+   const Statistics& statistics() const { return _statistics; }
+   Statistics& statistics() { return _statistics; }
 protected:
    virtual void write(QDataStream& stream) const override final;
    virtual void read(QDataStream& stream) override final;
 private:
    qint64 _start;
    QVector<Pair> _pairs;
+   Statistics _statistics;
 };
 
 
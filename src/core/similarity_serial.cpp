@@ -38,18 +38,36 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::Serial::execute(const EAbs
    // initialize result block
    ResultBlock* resultBlock {new ResultBlock(workBlock->index(), workBlock->start())};
 
+   // initialize statistics, timing each stage of every pair
+   Statistics& statistics {resultBlock->statistics()};
+   statistics.worker = Statistics::workerName();
+   statistics.blocks = 1;
+   statistics.clusterSizes.resize(_base->_maxClusters + 1);
+
+   QElapsedTimer timer;
+   timer.start();
+
    // initialize workspace
    QVector<Pairwise::Vector2> X(_base->_input->getSampleSize());
    QVector<qint8> labels(_base->_input->getSampleSize());
 
-   // iterate through all pairs
+   // iterate through all pairs, which are either consecutive or listed by the block
    Pairwise::Index index {workBlock->start()};
 
    for ( int i = 0; i < workBlock->size(); ++i )
    {
+      if ( !workBlock->indices().isEmpty() )
+      {
+         index = Pairwise::Index::unpack(workBlock->indices().at(i));
+      }
+
       // fetch pairwise input data
+      qint64 t0 {timer.nsecsElapsed()};
+
       int numSamples = fetchPair(index, X, labels);
 
+      qint64 t1 {timer.nsecsElapsed()};
+
       // compute clusters
       qint8 K {1};
 
@@ -66,8 +84,12 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::Serial::execute(const EAbs
             _base->_removePreOutliers,
             _base->_removePostOutliers
          );
+
+         statistics.clusteringIterations += _base->_clusModel->iterations();
       }
 
+      qint64 t2 {timer.nsecsElapsed()};
+
       // compute correlations
       QVector<float> correlations = _base->_corrModel->compute(
          X,
@@ -76,6 +98,15 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::Serial::execute(const EAbs
          _base->_minSamples
       );
 
+      qint64 t3 {timer.nsecsElapsed()};
+
+      statistics.times[Statistics::Fetch] += t1 - t0;
+      statistics.times[Statistics::Clustering] += t2 - t1;
+      statistics.times[Statistics::Correlation] += t3 - t2;
+      statistics.pairs += 1;
+      statistics.skippedPairs += (numSamples < _base->_minSamples);
+      statistics.clusterSizes[K] += 1;
+
       // save pairwise output data
       Pair pair;
       pair.K = K;
@@ -96,6 +127,8 @@ std::unique_ptr<EAbstractAnalytic::Block> Similarity::Serial::execute(const EAbs
       ++index;
    }
 
+   statistics.times[Statistics::Execute] += timer.nsecsElapsed();
+
    // return result block
    return unique_ptr<EAbstractAnalytic::Block>(resultBlock);
 }
@@ -0,0 +1,121 @@
+#include "similarity_statistics.h"
+
+
+
+QString Similarity::Statistics::workerName()
+{
+   // identify workers by host and process, which distinguishes MPI ranks
+   return QString("%1:%2").arg(QSysInfo::machineHostName()).arg(QCoreApplication::applicationPid());
+}
+
+
+
+
+
+
+void Similarity::Statistics::add(const Statistics& other)
+{
+   blocks += other.blocks;
+   pairs += other.pairs;
+   skippedPairs += other.skippedPairs;
+   clusteringIterations += other.clusteringIterations;
+   bytesWritten += other.bytesWritten;
+
+   if ( clusterSizes.size() < other.clusterSizes.size() )
+   {
+      clusterSizes.resize(other.clusterSizes.size());
+   }
+
+   for ( int k = 0; k < other.clusterSizes.size(); ++k )
+   {
+      clusterSizes[k] += other.clusterSizes[k];
+   }
+
+   for ( int i = 0; i < StageSize; ++i )
+   {
+      times[i] += other.times[i];
+   }
+}
+
+
+
+
+
+
+void Similarity::Statistics::write(QDataStream& stream) const
+{
+   stream << worker;
+   stream << blocks;
+   stream << pairs;
+   stream << skippedPairs;
+   stream << clusteringIterations;
+   stream << bytesWritten;
+   stream << clusterSizes;
+
+   for ( int i = 0; i < StageSize; ++i )
+   {
+      stream << times[i];
+   }
+}
+
+
+
+
+
+
+void Similarity::Statistics::read(QDataStream& stream)
+{
+   stream >> worker;
+   stream >> blocks;
+   stream >> pairs;
+   stream >> skippedPairs;
+   stream >> clusteringIterations;
+   stream >> bytesWritten;
+   stream >> clusterSizes;
+
+   for ( int i = 0; i < StageSize; ++i )
+   {
+      stream >> times[i];
+   }
+}
+
+
+
+
+
+
+QJsonObject Similarity::Statistics::toJson() const
+{
+   static const char* STAGE_NAMES[StageSize]
+   {
+      "fetch"
+      ,"clustering"
+      ,"correlation"
+      ,"execute"
+      ,"deserialize"
+      ,"process"
+   };
+
+   QJsonArray sizes;
+   for ( qint64 count : clusterSizes )
+   {
+      sizes.append((double)count);
+   }
+
+   QJsonObject seconds;
+   for ( int i = 0; i < StageSize; ++i )
+   {
+      seconds.insert(STAGE_NAMES[i], times[i] / 1e9);
+   }
+
+   QJsonObject object;
+   object.insert("blocks", (double)blocks);
+   object.insert("pairs", (double)pairs);
+   object.insert("skippedPairs", (double)skippedPairs);
+   object.insert("clusteringIterations", (double)clusteringIterations);
+   object.insert("bytesWritten", (double)bytesWritten);
+   object.insert("clusterSizes", sizes);
+   object.insert("seconds", seconds);
+
+   return object;
+}
@@ -0,0 +1,39 @@
+#ifndef SIMILARITY_STATISTICS_H
+#define SIMILARITY_STATISTICS_H
+#include "similarity.h"
+
+
+
+class Similarity::Statistics
+{
+public:
+   enum Stage
+   {
+      Fetch = 0
+      ,Clustering
+      ,Correlation
+      ,Execute
+      ,Deserialize
+      ,Process
+      ,StageSize
+   };
+   static QString workerName();
+   void add(const Statistics& other);
+   void write(QDataStream& stream) const;
+   void read(QDataStream& stream);
+   QJsonObject toJson() const;
+   QString worker;
+   qint64 blocks {0};
+   qint64 pairs {0};
+   qint64 skippedPairs {0};
+   qint64 clusteringIterations {0};
+   qint64 bytesWritten {0};
+   // number of pairs with each cluster size, indexed by cluster size
+   QVector<qint64> clusterSizes;
+   // time spent in each stage, in nanoseconds
+   qint64 times[StageSize] {0};
+};
+
+
+
+#endif
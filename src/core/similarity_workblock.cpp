@@ -17,9 +17,22 @@ Similarity::WorkBlock::WorkBlock(int index, qint64 start, qint64 size):
 
 
 
+Similarity::WorkBlock::WorkBlock(int index, qint64 start, qint64 size, const QVector<Pairwise::PackedIndex>& indices):
+   EAbstractAnalytic::Block(index),
+   _start(start),
+   _size(size),
+   _indices(indices)
+{
+}
+
+
+
+
+
+
 void Similarity::WorkBlock::write(QDataStream& stream) const
 {
-   stream << _start << _size;
+   stream << _start << _size << _indices;
 }
 
 
@@ -29,5 +42,5 @@ void Similarity::WorkBlock::write(QDataStream& stream) const
 
 void Similarity::WorkBlock::read(QDataStream& stream)
 {
-   stream >> _start >> _size;
+   stream >> _start >> _size >> _indices;
 }
@@ -10,14 +10,19 @@ class Similarity::WorkBlock : public EAbstractAnalytic::Block
 public:
    explicit WorkBlock() = default;
    explicit WorkBlock(int index, qint64 start, qint64 size);
+   explicit WorkBlock(int index, qint64 start, qint64 size, const QVector<Pairwise::PackedIndex>& indices);
    qint64 start() const { return _start; }
    qint64 size() const { return _size; }
+   // indexes of the pairs of a run over a subset of pairs, otherwise the pairs of the
+   // block are the consecutive pairs starting at pair start
+   const QVector<Pairwise::PackedIndex>& indices() const { return _indices; }
 protected:
    virtual void write(QDataStream& stream) const override final;
    virtual void read(QDataStream& stream) override final;
 private:
    qint64 _start;
    qint64 _size;
+   QVector<Pairwise::PackedIndex> _indices;
 };
 
 
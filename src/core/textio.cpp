@@ -0,0 +1,454 @@
+#include "textio.h"
+
+#include <cmath>
+#include <limits>
+
+
+
+namespace TextIO {
+
+
+
+
+
+
+const char* lineEnd(const char* p, const char* end)
+{
+   // find next newline or the end of the buffer if this is the last line
+   const char* newline {static_cast<const char*>(memchr(p, '\n', end - p))};
+
+   return newline ? newline : end;
+}
+
+
+
+
+
+
+bool parseFloat(const char* begin, const char* end, float* value)
+{
+   static const double POWERS_OF_TEN[]
+   {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+   };
+
+   const char* p {begin};
+
+   // parse sign
+   bool negative {false};
+   if ( p != end && (*p == '-' || *p == '+') )
+   {
+      negative = (*p == '-');
+      ++p;
+   }
+
+   // parse integer and fraction digits into mantissa
+   quint64 mantissa {0};
+   int digits {0};
+   int exponent {0};
+   bool exact {true};
+   bool any {false};
+
+   for ( ; p != end && *p >= '0' && *p <= '9'; ++p )
+   {
+      if ( digits < 19 )
+      {
+         mantissa = mantissa * 10 + (*p - '0');
+         digits += (mantissa != 0);
+      }
+      else
+      {
+         ++exponent;
+         exact &= (*p == '0');
+      }
+      any = true;
+   }
+
+   if ( p != end && *p == '.' )
+   {
+      for ( ++p; p != end && *p >= '0' && *p <= '9'; ++p )
+      {
+         if ( digits < 19 )
+         {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += (mantissa != 0);
+            --exponent;
+         }
+         else
+         {
+            exact &= (*p == '0');
+         }
+         any = true;
+      }
+   }
+
+   // parse exponent
+   if ( any && p != end && (*p == 'e' || *p == 'E') )
+   {
+      ++p;
+
+      bool negativeExponent {false};
+      if ( p != end && (*p == '-' || *p == '+') )
+      {
+         negativeExponent = (*p == '-');
+         ++p;
+      }
+
+      int explicitExponent {0};
+      bool anyExponent {false};
+      for ( ; p != end && *p >= '0' && *p <= '9'; ++p )
+      {
+         explicitExponent = qMin(explicitExponent * 10 + (*p - '0'), 100000);
+         anyExponent = true;
+      }
+
+      any = anyExponent;
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+   }
+
+   // use the direct conversion if the whole token was consumed and it is exact, which is
+   // correctly rounded because both the mantissa and the power of ten are exact doubles
+   if ( any && p == end && exact && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22 )
+   {
+      double result {(double)mantissa};
+      result = (exponent < 0) ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+      *value = negative ? -result : result;
+      return true;
+   }
+
+   // otherwise fall back to the general conversion, which also handles nan and inf
+   bool ok;
+   double result {QByteArray::fromRawData(begin, end - begin).toDouble(&ok)};
+   *value = result;
+   return ok;
+}
+
+
+
+
+
+
+bool parseInt(const char* begin, const char* end, qint32* value)
+{
+   const char* p {begin};
+
+   // parse sign
+   bool negative {false};
+   if ( p != end && (*p == '-' || *p == '+') )
+   {
+      negative = (*p == '-');
+      ++p;
+   }
+
+   // parse digits, making sure there is at least one and the value fits in 32 bits
+   if ( p == end )
+   {
+      return false;
+   }
+
+   qint64 result {0};
+   for ( ; p != end; ++p )
+   {
+      if ( *p < '0' || *p > '9' )
+      {
+         return false;
+      }
+
+      result = result * 10 + (*p - '0');
+
+      if ( result > (qint64)std::numeric_limits<qint32>::max() + 1 )
+      {
+         return false;
+      }
+   }
+
+   result = negative ? -result : result;
+
+   if ( result > std::numeric_limits<qint32>::max() )
+   {
+      return false;
+   }
+
+   *value = result;
+   return true;
+}
+
+
+
+
+
+
+bool packMask(const char* begin, const char* end, char* data)
+{
+   const char* p {begin};
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+   // convert eight digits at a time into four bytes of packed samples, using 64-bit
+   // arithmetic on all eight characters at once
+   for ( ; end - p >= 8; p += 8, data += 4 )
+   {
+      quint64 word;
+      memcpy(&word, p, sizeof(quint64));
+
+      // make sure every character is a digit, which has a high nibble of 3 and a low
+      // nibble that does not carry when 6 is added to it
+      if ( (word & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull
+           || (((word & 0x0F0F0F0F0F0F0F0Full) + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) != 0 )
+      {
+         return false;
+      }
+
+      // merge each pair of digit values into one byte and then gather the bytes
+      quint64 x {word & 0x0F0F0F0F0F0F0F0Full};
+      x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+      x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+      x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+
+      quint32 packed {(quint32)x};
+      memcpy(data, &packed, sizeof(quint32));
+   }
+#endif
+
+   // convert remaining digits one at a time, in the same layout as the cluster matrix
+   for ( int i = 0; p != end; ++p, ++i )
+   {
+      if ( *p < '0' || *p > '9' )
+      {
+         return false;
+      }
+
+      if ( i % 2 == 0 )
+      {
+         data[i / 2] = *p - '0';
+      }
+      else
+      {
+         data[i / 2] |= (*p - '0') << 4;
+      }
+   }
+
+   return true;
+}
+
+
+
+
+
+
+char* formatInt(char* p, qint64 value)
+{
+   // write sign
+   quint64 magnitude {(quint64)value};
+   if ( value < 0 )
+   {
+      *p++ = '-';
+      magnitude = 0 - magnitude;
+   }
+
+   // write digits in reverse order and then copy them out in order
+   char digits[20];
+   int size {0};
+   do
+   {
+      digits[size++] = '0' + magnitude % 10;
+      magnitude /= 10;
+   }
+   while ( magnitude != 0 );
+
+   while ( size > 0 )
+   {
+      *p++ = digits[--size];
+   }
+
+   return p;
+}
+
+
+
+
+
+
+char* formatFloat(char* p, float value, int precision)
+{
+   static const double POWERS_OF_TEN[]
+   {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17
+   };
+
+   // write special values the way the general conversion does
+   if ( std::isnan(value) )
+   {
+      memcpy(p, "nan", 3);
+      return p + 3;
+   }
+
+   if ( std::signbit(value) )
+   {
+      *p++ = '-';
+      value = -value;
+   }
+
+   if ( std::isinf(value) )
+   {
+      memcpy(p, "inf", 3);
+      return p + 3;
+   }
+
+   if ( value == 0 )
+   {
+      *p++ = '0';
+      return p;
+   }
+
+   // values outside of the range where the general format has no exponent, or with a
+   // precision outside of the range of the table, are written by the general conversion
+   const double magnitude {value};
+   precision = qMax(precision, 1);
+
+   if ( precision > 17 || magnitude < 1e-4 || magnitude >= POWERS_OF_TEN[precision] )
+   {
+      return p + snprintf(p, 32, "%.*g", precision, magnitude);
+   }
+
+   // find the decimal exponent of the value
+   int exponent {-4};
+   while ( exponent < precision - 1 && magnitude >= POWERS_OF_TEN[exponent + 5] / 1e4 )
+   {
+      ++exponent;
+   }
+
+   // scale the value to the given number of digits, which is exact when the power of ten
+   // is at most 1e12 because a float mantissa times such a power fits in a double, and
+   // correct the exponent if the comparison above was off by one near a power of ten
+   const double lower {POWERS_OF_TEN[precision - 1]};
+   const double upper {POWERS_OF_TEN[precision]};
+   int scale {precision - 1 - exponent};
+   double scaled {(scale <= 12) ? magnitude * POWERS_OF_TEN[scale] : 0};
+
+   if ( scale <= 12 && scaled < lower )
+   {
+      --exponent;
+      ++scale;
+      scaled = magnitude * POWERS_OF_TEN[scale];
+   }
+   else if ( scale <= 12 && scaled >= upper )
+   {
+      ++exponent;
+      --scale;
+      scaled = magnitude * POWERS_OF_TEN[scale];
+   }
+
+   if ( scale < 0 || scale > 12 || exponent < -4 )
+   {
+      return p + snprintf(p, 32, "%.*g", precision, magnitude);
+   }
+
+   // round to nearest with ties to even, as the general conversion does
+   qint64 digits {(qint64)scaled};
+   double fraction {scaled - digits};
+   if ( fraction > 0.5 || (fraction == 0.5 && digits % 2 == 1) )
+   {
+      ++digits;
+   }
+
+   // move to the next exponent if rounding carried into another digit
+   if ( digits == (qint64)upper )
+   {
+      digits = (qint64)lower;
+      ++exponent;
+   }
+
+   if ( digits < (qint64)lower || exponent > precision - 1 )
+   {
+      return p + snprintf(p, 32, "%.*g", precision, magnitude);
+   }
+
+   // write the digits with the decimal point, leaving out trailing zeros
+   char text[17];
+   for ( int i = precision - 1; i >= 0; --i )
+   {
+      text[i] = '0' + digits % 10;
+      digits /= 10;
+   }
+
+   int size {precision};
+   while ( size > 1 && text[size - 1] == '0' )
+   {
+      --size;
+   }
+
+   if ( exponent >= 0 )
+   {
+      int whole {exponent + 1};
+      for ( int i = 0; i < whole; ++i )
+      {
+         *p++ = (i < size) ? text[i] : '0';
+      }
+
+      if ( size > whole )
+      {
+         *p++ = '.';
+         for ( int i = whole; i < size; ++i )
+         {
+            *p++ = text[i];
+         }
+      }
+   }
+   else
+   {
+      *p++ = '0';
+      *p++ = '.';
+      for ( int i = exponent + 1; i < 0; ++i )
+      {
+         *p++ = '0';
+      }
+      for ( int i = 0; i < size; ++i )
+      {
+         *p++ = text[i];
+      }
+   }
+
+   return p;
+}
+
+
+
+
+
+
+char* unpackMask(char* p, const char* data, int size)
+{
+   int i {0};
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+   // expand four bytes of packed samples into eight digits at a time, using 64-bit
+   // arithmetic to spread each nibble into its own byte
+   for ( ; i + 8 <= size; i += 8, p += 8 )
+   {
+      quint32 packed;
+      memcpy(&packed, data + i / 2, sizeof(quint32));
+
+      quint64 x {packed};
+      x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+      x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+      x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+      x += 0x3030303030303030ull;
+
+      memcpy(p, &x, sizeof(quint64));
+   }
+#endif
+
+   // expand remaining samples one at a time
+   for ( ; i < size; ++i )
+   {
+      *p++ = '0' + ((data[i / 2] >> (i % 2 * 4)) & 0x0F);
+   }
+
+   return p;
+}
+
+
+
+}
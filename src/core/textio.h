@@ -0,0 +1,25 @@
+#ifndef TEXTIO_H
+#define TEXTIO_H
+#include <ace/core/core.h>
+
+namespace TextIO
+{
+   inline bool isSpace(char c)
+      { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+   inline const char* skipSpace(const char* p, const char* end)
+      { while ( p != end && isSpace(*p) ) { ++p; } return p; }
+
+   inline const char* skipToken(const char* p, const char* end)
+      { while ( p != end && !isSpace(*p) ) { ++p; } return p; }
+
+   const char* lineEnd(const char* p, const char* end);
+   bool parseFloat(const char* begin, const char* end, float* value);
+   bool parseInt(const char* begin, const char* end, qint32* value);
+   bool packMask(const char* begin, const char* end, char* data);
+   char* formatInt(char* p, qint64 value);
+   char* formatFloat(char* p, float value, int precision = 6);
+   char* unpackMask(char* p, const char* data, int size);
+}
+
+#endif
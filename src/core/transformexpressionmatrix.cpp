@@ -0,0 +1,93 @@
+#include "transformexpressionmatrix.h"
+#include "transformexpressionmatrix_input.h"
+#include "datafactory.h"
+
+
+
+
+
+
+int TransformExpressionMatrix::size() const
+{
+   return 1;
+}
+
+
+
+
+
+
+void TransformExpressionMatrix::process(const EAbstractAnalytic::Block* result)
+{
+   Q_UNUSED(result);
+
+   // make sure input expression matrix has not already been transformed
+   if ( _input->getTransform() != Transform::None )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Input expression matrix has already been transformed with %1.")
+                   .arg(ExpressionMatrix::TRANSFORM_NAMES.at(static_cast<int>(_input->getTransform()))));
+      throw e;
+   }
+
+   // copy gene and sample names from input expression matrix
+   QStringList geneNames;
+   for ( auto& geneName : _input->getGeneNames().toArray() )
+   {
+      geneNames.append(geneName.toString());
+   }
+
+   QStringList sampleNames;
+   for ( auto& sampleName : _input->getSampleNames().toArray() )
+   {
+      sampleNames.append(sampleName.toString());
+   }
+
+   // initialize output expression matrix
+   _output->initialize(geneNames, sampleNames, _storage);
+
+   // transform genes in windows of rows, reading and writing each window as one block
+   const int WINDOW_SIZE {1024};
+   const int geneSize {_input->getGeneSize()};
+   const int sampleSize {_input->getSampleSize()};
+   QVector<Expression> expressions(WINDOW_SIZE * sampleSize);
+
+   for ( int window = 0; window < geneSize; window += WINDOW_SIZE )
+   {
+      const int windowSize {qMin(WINDOW_SIZE, geneSize - window)};
+
+      _input->readGenes(window, windowSize, expressions.data());
+      ExpressionMatrix::applyTransform(_transform, expressions.data(), (qint64)windowSize * sampleSize);
+      _output->writeGenes(window, windowSize, expressions.constData());
+   }
+
+   // set transform used in expression matrix
+   _output->setTransform(_transform);
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input* TransformExpressionMatrix::makeInput()
+{
+   return new Input(this);
+}
+
+
+
+
+
+
+void TransformExpressionMatrix::initialize()
+{
+   if ( !_input || !_output )
+   {
+      E_MAKE_EXCEPTION(e);
+      e.setTitle(tr("Invalid Argument"));
+      e.setDetails(tr("Did not get valid input and/or output arguments."));
+      throw e;
+   }
+}
@@ -0,0 +1,30 @@
+#ifndef TRANSFORMEXPRESSIONMATRIX_H
+#define TRANSFORMEXPRESSIONMATRIX_H
+#include <ace/core/core.h>
+
+#include "expressionmatrix.h"
+
+
+
+class TransformExpressionMatrix : public EAbstractAnalytic
+{
+   Q_OBJECT
+public:
+   class Input;
+   virtual int size() const override final;
+   virtual void process(const EAbstractAnalytic::Block* result) override final;
+   virtual EAbstractAnalytic::Input* makeInput() override final;
+   virtual void initialize();
+private:
+   using Expression = ExpressionMatrix::Expression;
+   using Transform = ExpressionMatrix::Transform;
+   using Storage = ExpressionMatrix::Storage;
+   ExpressionMatrix* _input {nullptr};
+   ExpressionMatrix* _output {nullptr};
+   Transform _transform {Transform::None};
+   Storage _storage {Storage::Float32};
+};
+
+
+
+#endif
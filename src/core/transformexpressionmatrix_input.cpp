@@ -0,0 +1,134 @@
+#include "transformexpressionmatrix_input.h"
+#include "datafactory.h"
+
+
+
+
+
+
+TransformExpressionMatrix::Input::Input(TransformExpressionMatrix* parent):
+   EAbstractAnalytic::Input(parent),
+   _base(parent)
+{}
+
+
+
+
+
+
+int TransformExpressionMatrix::Input::size() const
+{
+   return Total;
+}
+
+
+
+
+
+
+EAbstractAnalytic::Input::Type TransformExpressionMatrix::Input::type(int index) const
+{
+   switch (index)
+   {
+   case InputData: return Type::DataIn;
+   case OutputData: return Type::DataOut;
+   case TransformType: return Type::Selection;
+   case StorageType: return Type::Selection;
+   default: return Type::Boolean;
+   }
+}
+
+
+
+
+
+
+QVariant TransformExpressionMatrix::Input::data(int index, Role role) const
+{
+   switch (index)
+   {
+   case InputData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("input");
+      case Role::Title: return tr("Input:");
+      case Role::WhatsThis: return tr("Input untransformed expression matrix.");
+      case Role::DataType: return DataFactory::ExpressionMatrixType;
+      default: return QVariant();
+      }
+   case OutputData:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("output");
+      case Role::Title: return tr("Output:");
+      case Role::WhatsThis: return tr("Output expression matrix that will contain transformed expression data.");
+      case Role::DataType: return DataFactory::ExpressionMatrixType;
+      default: return QVariant();
+      }
+   case TransformType:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("transform");
+      case Role::Title: return tr("Transform:");
+      case Role::WhatsThis: return tr("Element-wise transformation to apply to expression data.");
+      case Role::Default: return ExpressionMatrix::TRANSFORM_NAMES.first();
+      case Role::SelectionValues: return ExpressionMatrix::TRANSFORM_NAMES;
+      default: return QVariant();
+      }
+   case StorageType:
+      switch (role)
+      {
+      case Role::CommandLineName: return QString("storage");
+      case Role::Title: return tr("Storage:");
+      case Role::WhatsThis: return tr("Precision in which expressions are stored. float16 halves the size of the matrix and keeps missing values, but only holds magnitudes up to 65504 with about three significant digits.");
+      case Role::Default: return ExpressionMatrix::STORAGE_NAMES.first();
+      case Role::SelectionValues: return ExpressionMatrix::STORAGE_NAMES;
+      default: return QVariant();
+      }
+   default: return QVariant();
+   }
+}
+
+
+
+
+
+
+void TransformExpressionMatrix::Input::set(int index, const QVariant& value)
+{
+   switch (index)
+   {
+   case TransformType:
+      _base->_transform = static_cast<Transform>(ExpressionMatrix::TRANSFORM_NAMES.indexOf(value.toString()));
+      break;
+   case StorageType:
+      _base->_storage = static_cast<Storage>(ExpressionMatrix::STORAGE_NAMES.indexOf(value.toString()));
+      break;
+   }
+}
+
+
+
+
+
+
+void TransformExpressionMatrix::Input::set(int, QFile*)
+{}
+
+
+
+
+
+
+void TransformExpressionMatrix::Input::set(int index, EAbstractData* data)
+{
+   switch (index)
+   {
+   case InputData:
+      _base->_input = data->cast<ExpressionMatrix>();
+      break;
+   case OutputData:
+      _base->_output = data->cast<ExpressionMatrix>();
+      break;
+   }
+}
@@ -0,0 +1,32 @@
+#ifndef TRANSFORMEXPRESSIONMATRIX_INPUT_H
+#define TRANSFORMEXPRESSIONMATRIX_INPUT_H
+#include "transformexpressionmatrix.h"
+
+
+
+class TransformExpressionMatrix::Input : public EAbstractAnalytic::Input
+{
+   Q_OBJECT
+public:
+   enum Argument
+   {
+      InputData = 0
+      ,OutputData
+      ,TransformType
+      ,StorageType
+      ,Total
+   };
+   explicit Input(TransformExpressionMatrix* parent);
+   virtual int size() const override final;
+   virtual EAbstractAnalytic::Input::Type type(int index) const override final;
+   virtual QVariant data(int index, Role role) const override final;
+   virtual void set(int index, const QVariant& value) override final;
+   virtual void set(int index, QFile* file) override final;
+   virtual void set(int index, EAbstractData* data) override final;
+private:
+   TransformExpressionMatrix* _base;
+};
+
+
+
+#endif
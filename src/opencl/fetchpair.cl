@@ -10,9 +10,10 @@
  * Fetch pairwise data for a pair of genes. Samples which are nan or are
  * below a threshold are excluded.
  *
- * @param expressions
+ * @param expressions  float32 expressions, or packed float16 expressions
+ * @param halfPrecision  whether expressions are stored as float16
  * @param sampleSize
- * @param in_index
+ * @param in_index  packed pairwise indices, gene x in the upper 32 bits
  * @param minExpression
  * @param out_X
  * @param out_N
@@ -20,8 +21,9 @@
  */
 __kernel void fetchPair(
    __global const float *expressions,
+   int halfPrecision,
    int sampleSize,
-   __global const int2 *in_index,
+   __global const long *in_index,
    int minExpression,
    __global Vector2 *out_X,
    __global int *out_N,
@@ -30,7 +32,7 @@ __kernel void fetchPair(
    int i = get_global_id(0);
 
    // initialize variables
-   int2 index = in_index[i];
+   int2 index = (int2) ( (int)(in_index[i] >> 32), (int)(in_index[i] & 0xFFFFFFFF) );
    __global Vector2 *X = &out_X[i * sampleSize];
    __global char *labels = &out_labels[i * sampleSize];
    __global int *p_N = &out_N[i];
@@ -43,23 +45,27 @@ __kernel void fetchPair(
    // index into gene expressions
    __global const float *gene1 = &expressions[index.x * sampleSize];
    __global const float *gene2 = &expressions[index.y * sampleSize];
+   __global const half *halves = (__global const half *)expressions;
 
    // populate X with shared expressions of gene pair
    int N = 0;
 
    for ( int i = 0; i < sampleSize; ++i )
    {
-      if ( isnan(gene1[i]) || isnan(gene2[i]) )
+      float x = halfPrecision ? vload_half(index.x * sampleSize + i, halves) : gene1[i];
+      float y = halfPrecision ? vload_half(index.y * sampleSize + i, halves) : gene2[i];
+
+      if ( isnan(x) || isnan(y) )
       {
          labels[i] = -9;
       }
-      else if ( gene1[i] < minExpression || gene2[i] < minExpression )
+      else if ( x < minExpression || y < minExpression )
       {
          labels[i] = -6;
       }
       else
       {
-         X[N].v2 = (float2) ( gene1[i], gene2[i] );
+         X[N].v2 = (float2) ( x, y );
          N++;
 
          labels[i] = 0;
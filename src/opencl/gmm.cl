@@ -422,6 +422,7 @@ bool GMM_fit(
    __global char *labels,
    float *logL,
    float *entropy,
+   int *iterations,
    __global Component *components,
    __global Vector2 *MP,
    __global int *counts,
@@ -458,6 +459,8 @@ bool GMM_fit(
 
    for ( int t = 0; t < MAX_ITERATIONS; ++t )
    {
+      ++(*iterations);
+
       // E step
       // compute gamma, log-likelihood
       GMM_calcLogMvNorm(components, K, X, N, loggamma);
@@ -566,7 +569,8 @@ __kernel void GMM_compute(
    __global float *work_loggamma,
    __global float *work_logGamma,
    __global char *out_K,
-   __global char *out_labels)
+   __global char *out_labels,
+   __global int *out_iterations)
 {
    int i = get_global_id(0);
 
@@ -592,7 +596,9 @@ __kernel void GMM_compute(
       markOutliers(X, N, 1, bestLabels, 0, -7, work);
    }
 
-   // perform clustering only if there are enough samples
+   // perform clustering only if there are enough samples, counting the iterations
+   // of every model
+   int iterations = 0;
    *bestK = 0;
 
    if ( N >= minSamples )
@@ -607,7 +613,7 @@ __kernel void GMM_compute(
 
          bool success = GMM_fit(
             X, N, K,
-            labels, &logL, &entropy,
+            labels, &logL, &entropy, &iterations,
             components,
             MP, counts,
             logpi, loggamma, logGamma
@@ -661,4 +667,7 @@ __kernel void GMM_compute(
          }
       }
    }
+
+   // save number of iterations
+   out_iterations[i] = iterations;
 }
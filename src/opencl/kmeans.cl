@@ -54,6 +54,7 @@ float KMeans_computeLogLikelihood(
 void KMeans_fit(
    __global const Vector2 *X, int N, int K,
    float *logL,
+   int *iterations,
    __global char *labels,
    __global Vector2 *means,
    __global char *y,
@@ -79,6 +80,8 @@ void KMeans_fit(
       // iterate K means until convergence
       for ( int t = 0; t < MAX_ITERATIONS; ++t )
       {
+         ++(*iterations);
+
          // compute new labels
          for ( int i = 0; i < N; ++i )
          {
@@ -205,7 +208,8 @@ __kernel void KMeans_compute(
    __global char *work_labels,
    __global Vector2 *work_means,
    __global char *out_K,
-   __global char *out_labels)
+   __global char *out_labels,
+   __global int *out_iterations)
 {
    int i = get_global_id(0);
 
@@ -228,7 +232,9 @@ __kernel void KMeans_compute(
       markOutliers(X, N, 1, bestLabels, 0, -7, work);
    }
 
-   // perform clustering only if there are enough samples
+   // perform clustering only if there are enough samples, counting the iterations
+   // of every model
+   int iterations = 0;
    *bestK = 0;
 
    if ( N >= minSamples )
@@ -239,7 +245,7 @@ __kernel void KMeans_compute(
       {
          // run each clustering model
          float logL;
-         KMeans_fit(X, N, K, &logL, labels, means, y, y_next);
+         KMeans_fit(X, N, K, &logL, &iterations, labels, means, y, y_next);
 
          // evaluate model
          float value = KMeans_computeBIC(K, logL, N, 2);
@@ -274,4 +280,7 @@ __kernel void KMeans_compute(
          }
       }
    }
+
+   // save number of iterations
+   out_iterations[i] = iterations;
 }
@@ -7,8 +7,11 @@
 #include "testexpressionmatrix.h"
 #include "testimportcorrelationmatrix.h"
 #include "testimportexpressionmatrix.h"
+#include "testindex.h"
+#include "testpairset.h"
 #include "testrmt.h"
 #include "testsimilarity.h"
+#include "testtextio.h"
 
 
 
@@ -35,8 +38,11 @@ int main(int argc, char **argv)
 		ASSERT_TEST(new TestExpressionMatrix);
 		// ASSERT_TEST(new TestImportCorrelationMatrix);
 		// ASSERT_TEST(new TestImportExpressionMatrix);
+		ASSERT_TEST(new TestIndex);
+		ASSERT_TEST(new TestPairSet);
 		// ASSERT_TEST(new TestRMT);
 		// ASSERT_TEST(new TestSimilarity);
+		ASSERT_TEST(new TestTextIO);
 	}
 	catch ( EException& e )
 	{
@@ -86,4 +86,83 @@ void TestCorrelationMatrix::test()
 			QCOMPARE(pair.at(k, 0), testPair.correlations.at(k));
 		}
 	}
+
+	QVERIFY(!pair.hasNext());
+
+	// read and verify correlation data from file in reverse order
+	for ( int i = testPairs.size() - 1; i >= 0; --i )
+	{
+		auto& testPair {testPairs.at(i)};
+
+		pair.read(testPair.index);
+
+		QCOMPARE(pair.clusterSize(), testPair.correlations.size());
+
+		for ( int k = 0; k < pair.clusterSize(); ++k )
+		{
+			QCOMPARE(pair.at(k, 0), testPair.correlations.at(k));
+		}
+	}
+
+	// read and verify correlation data from file one row at a time
+	QVector<Pairwise::Matrix::Row> rows {matrix->readRows(0, numGenes)};
+	int next {0};
+
+	QCOMPARE(rows.size(), numGenes);
+
+	for ( int x = 0; x < numGenes; ++x )
+	{
+		auto& row {rows.at(x)};
+
+		for ( int y = 0; y < x; ++y )
+		{
+			pair.read(row, y);
+
+			if ( next < testPairs.size() && testPairs.at(next).index == Pairwise::Index(x, y) )
+			{
+				auto& testPair {testPairs.at(next++)};
+
+				QCOMPARE(pair.clusterSize(), testPair.correlations.size());
+
+				for ( int k = 0; k < pair.clusterSize(); ++k )
+				{
+					QCOMPARE(pair.at(k, 0), testPair.correlations.at(k));
+				}
+			}
+			else
+			{
+				QVERIFY(pair.isEmpty());
+			}
+		}
+	}
+
+	QCOMPARE(next, testPairs.size());
+
+	// verify the pairs of each gene against pairs read one at a time
+	CorrelationMatrix::Pair expected(matrix);
+
+	for ( int gene = 0; gene < numGenes; ++gene )
+	{
+		Pairwise::Matrix::Row row {matrix->readGene(gene)};
+
+		for ( int y = 0; y < numGenes; ++y )
+		{
+			if ( y == gene )
+			{
+				QCOMPARE(row.clusterSize(y), 0);
+				continue;
+			}
+
+			pair.read(row, y);
+			expected.read(Pairwise::Index(qMax(gene, y), qMin(gene, y)));
+
+			QCOMPARE(pair.index(), Pairwise::Index(qMax(gene, y), qMin(gene, y)));
+			QCOMPARE(pair.clusterSize(), expected.clusterSize());
+
+			for ( int k = 0; k < pair.clusterSize(); ++k )
+			{
+				QCOMPARE(pair.at(k, 0), expected.at(k, 0));
+			}
+		}
+	}
 }
@@ -60,3 +60,134 @@ void TestExpressionMatrix::test()
 	// verify expression data
 	QVERIFY(!memcmp(testExpressions.data(), expressions.get(), testExpressions.size() * sizeof(float)));
 }
+
+
+
+void TestExpressionMatrix::testTransform()
+{
+	// create random expression data with missing values
+	int size = 1000;
+	QVector<float> testExpressions(size);
+
+	for ( int i = 0; i < size; ++i )
+	{
+		testExpressions[i] = (i % 10 == 0) ? NAN : 0.01 + 100.0 * rand() / (double)RAND_MAX;
+	}
+
+	// verify each transform against the scalar function
+	QVector<float> expressions {testExpressions};
+
+	ExpressionMatrix::applyTransform(ExpressionMatrix::Transform::None, expressions.data(), size);
+	QVERIFY(!memcmp(testExpressions.data(), expressions.data(), size * sizeof(float)));
+
+	struct
+	{
+		ExpressionMatrix::Transform transform;
+		double (*function)(double);
+	} transforms[] {
+		{ ExpressionMatrix::Transform::NLog, log },
+		{ ExpressionMatrix::Transform::Log2, log2 },
+		{ ExpressionMatrix::Transform::Log10, log10 }
+	};
+
+	for ( auto& transform : transforms )
+	{
+		expressions = testExpressions;
+		ExpressionMatrix::applyTransform(transform.transform, expressions.data(), size);
+
+		for ( int i = 0; i < size; ++i )
+		{
+			if ( std::isnan(testExpressions[i]) )
+			{
+				QVERIFY(std::isnan(expressions[i]));
+			}
+			else
+			{
+				QVERIFY(fabs(expressions[i] - transform.function(testExpressions[i])) < 1e-5);
+			}
+		}
+	}
+}
+
+
+
+void TestExpressionMatrix::testHalf()
+{
+	// create random expression data with missing values and an odd number of samples,
+	// so that the matrix is not a whole number of 32-bit words
+	int numGenes = 10;
+	int numSamples = 7;
+	QVector<float> testExpressions(numGenes * numSamples);
+
+	for ( int i = 0; i < testExpressions.size(); ++i )
+	{
+		testExpressions[i] = (i % 5 == 0) ? NAN : -1000.0 + 2000.0 * rand() / (double)RAND_MAX;
+	}
+
+	// include infinities, which a log transform gives for zero expressions
+	testExpressions[1] = -INFINITY;
+	testExpressions[2] = INFINITY;
+
+	// create metadata
+	QStringList geneNames;
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		geneNames.append(QString::number(i));
+	}
+
+	QStringList sampleNames;
+	for ( int i = 0; i < numSamples; ++i )
+	{
+		sampleNames.append(QString::number(i));
+	}
+
+	// write data to file as float16
+	QString path {QDir::tempPath() + "/test.half.emx"};
+
+	{
+		std::unique_ptr<Ace::DataObject> dataRef {new Ace::DataObject(path, DataFactory::ExpressionMatrixType, EMetadata(EMetadata::Object))};
+		ExpressionMatrix* matrix {dataRef->data()->cast<ExpressionMatrix>()};
+
+		matrix->initialize(geneNames, sampleNames, ExpressionMatrix::Storage::Float16);
+		matrix->writeGenes(0, numGenes, testExpressions.constData());
+		matrix->finish();
+	}
+
+	// read expression data from file, which must detect the storage type from the header
+	std::unique_ptr<Ace::DataObject> dataRef {new Ace::DataObject(path)};
+	ExpressionMatrix* matrix {dataRef->data()->cast<ExpressionMatrix>()};
+
+	QCOMPARE(matrix->getStorage(), ExpressionMatrix::Storage::Float16);
+	QCOMPARE(matrix->getGeneSize(), numGenes);
+	QCOMPARE(matrix->getSampleSize(), numSamples);
+
+	// verify expression data is rounded to float16 and missing and infinite values are preserved
+	ExpressionMatrix::Gene gene(matrix);
+	for ( int i = 0; i < numGenes; ++i )
+	{
+		gene.read(i);
+
+		for ( int j = 0; j < numSamples; ++j )
+		{
+			float expected {testExpressions[i * numSamples + j]};
+
+			if ( std::isnan(expected) )
+			{
+				QVERIFY(std::isnan(gene.at(j)));
+			}
+			else if ( std::isinf(expected) )
+			{
+				QCOMPARE(gene.at(j), expected);
+			}
+			else
+			{
+				QCOMPARE(gene.at(j), ExpressionMatrix::fromHalf(ExpressionMatrix::toHalf(expected)));
+				QVERIFY(std::fabs(gene.at(j) - expected) <= std::fabs(expected) / 1024);
+			}
+		}
+	}
+
+	// verify values out of the range of float16 are rejected
+	float overflow[] {1e6};
+	QVERIFY_EXCEPTION_THROWN(matrix->writeGenes(0, 1, overflow), EException);
+}
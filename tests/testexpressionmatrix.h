@@ -9,6 +9,8 @@ class TestExpressionMatrix : public QObject
 	Q_OBJECT
 private slots:
 	void test();
+	void testTransform();
+	void testHalf();
 };
 
 
@@ -0,0 +1,45 @@
+#include <ace/core/core.h>
+
+#include "testindex.h"
+#include "pairwise_index.h"
+
+
+
+void TestIndex::test()
+{
+	// iterate through all pairs of a small gene set
+	int numGenes = 100;
+	Pairwise::Index index;
+	qint64 lastIndent = -1;
+
+	for ( int i = 0; i < numGenes * (numGenes - 1) / 2; ++i )
+	{
+		// verify that scalar construction agrees with incrementing
+		QCOMPARE(Pairwise::Index((qint64)i), index);
+
+		// verify that checked and unchecked indents agree and are sorted
+		for ( qint8 k = 0; k < Pairwise::Index::MAX_CLUSTER_SIZE; ++k )
+		{
+			qint64 indent = index.indent(k);
+
+			QCOMPARE(index.uncheckedIndent(k), indent);
+			QCOMPARE(Pairwise::Index::makeIndent(index.getX(), index.getY(), k), indent);
+			QVERIFY(indent > lastIndent);
+
+			lastIndent = indent;
+		}
+
+		// verify that packed indices round trip and preserve order
+		Pairwise::Index next {index};
+		++next;
+
+		QCOMPARE(Pairwise::Index::unpack(index.pack()), index);
+		QVERIFY(index.pack() < next.pack());
+
+		index = next;
+	}
+
+	// verify that the checked indent rejects invalid clusters
+	QVERIFY_EXCEPTION_THROWN(index.indent(-1), EException);
+	QVERIFY_EXCEPTION_THROWN(index.indent(Pairwise::Index::MAX_CLUSTER_SIZE), EException);
+}
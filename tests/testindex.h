@@ -0,0 +1,16 @@
+#ifndef TESTINDEX_H
+#define TESTINDEX_H
+#include <QtTest/QtTest>
+
+
+
+class TestIndex : public QObject
+{
+	Q_OBJECT
+private slots:
+	void test();
+};
+
+
+
+#endif
@@ -0,0 +1,87 @@
+#include <ace/core/core.h>
+
+#include "testpairset.h"
+#include "similarity_pairset.h"
+
+
+
+// verify that the pairs of a pair set match the expected pairs, both as a whole and
+// when read in blocks of several sizes whose boundaries fall anywhere within a row
+static void verifyPairs(const Similarity::PairSet& pairSet, const QVector<Pairwise::PackedIndex>& expected)
+{
+	QCOMPARE(pairSet.size(), (qint64)expected.size());
+	QCOMPARE(pairSet.indices(0, pairSet.size()), expected);
+
+	for ( qint64 blockSize : { 1, 3, 7, 64 } )
+	{
+		QVector<Pairwise::PackedIndex> indices;
+
+		for ( qint64 start = 0; start < pairSet.size(); start += blockSize )
+		{
+			QVector<Pairwise::PackedIndex> block {pairSet.indices(start, blockSize)};
+
+			QCOMPARE((qint64)block.size(), qMin(blockSize, pairSet.size() - start));
+			indices += block;
+		}
+
+		QCOMPARE(indices, expected);
+	}
+}
+
+
+
+void TestPairSet::testGenes()
+{
+	// select genes out of order with a duplicate, including the first and last gene
+	// and a run of unselected genes so that some rows are empty
+	int numGenes = 20;
+	QVector<qint32> genes {17, 0, 4, 5, 19, 4, 11};
+	QVector<bool> isGene(numGenes, false);
+
+	for ( auto gene : genes )
+	{
+		isGene[gene] = true;
+	}
+
+	for ( bool withAll : { true, false } )
+	{
+		// enumerate the expected pairs in the order of all pairs
+		QVector<Pairwise::PackedIndex> expected;
+
+		for ( Pairwise::Index index; index.getX() < numGenes; ++index )
+		{
+			bool isX {isGene.at(index.getX())};
+			bool isY {isGene.at(index.getY())};
+
+			if ( withAll ? (isX || isY) : (isX && isY) )
+			{
+				expected.append(index.pack());
+			}
+		}
+
+		verifyPairs(Similarity::PairSet(numGenes, genes, withAll), expected);
+	}
+}
+
+
+
+void TestPairSet::testPairs()
+{
+	// list pairs out of order with a duplicate
+	QVector<Pairwise::PackedIndex> pairs {
+		Pairwise::Index(9, 3).pack(),
+		Pairwise::Index(1, 0).pack(),
+		Pairwise::Index(5, 4).pack(),
+		Pairwise::Index(9, 3).pack(),
+		Pairwise::Index(5, 2).pack()
+	};
+
+	QVector<Pairwise::PackedIndex> expected {
+		Pairwise::Index(1, 0).pack(),
+		Pairwise::Index(5, 2).pack(),
+		Pairwise::Index(5, 4).pack(),
+		Pairwise::Index(9, 3).pack()
+	};
+
+	verifyPairs(Similarity::PairSet(pairs), expected);
+}
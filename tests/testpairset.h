@@ -0,0 +1,17 @@
+#ifndef TESTPAIRSET_H
+#define TESTPAIRSET_H
+#include <QtTest/QtTest>
+
+
+
+class TestPairSet : public QObject
+{
+	Q_OBJECT
+private slots:
+	void testGenes();
+	void testPairs();
+};
+
+
+
+#endif
@@ -4,7 +4,7 @@ TEMPLATE = app
 CONFIG += c++11 debug
 
 # Qt libraries
-QT += core testlib
+QT += core concurrent testlib
 
 # external libraries
 LIBS += -lOpenCL -L/usr/local/lib64/ -L$$(HOME)/software/lib -lacecore -lgsl -lgslcblas -llapack -llapacke
@@ -21,6 +21,7 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
 	../src/analyticfactory.cpp \
 	../src/ccmatrix.cpp \
+	../src/correlationmatrix_thresholdindex.cpp \
 	../src/correlationmatrix.cpp \
 	../src/datafactory.cpp \
 	../src/exportcorrelationmatrix_input.cpp \
@@ -30,10 +31,16 @@ SOURCES += \
 	../src/expressionmatrix.cpp \
 	../src/extract_input.cpp \
 	../src/extract.cpp \
+	../src/importbinaryexpressionmatrix_input.cpp \
+	../src/importbinaryexpressionmatrix.cpp \
 	../src/importcorrelationmatrix_input.cpp \
 	../src/importcorrelationmatrix.cpp \
 	../src/importexpressionmatrix_input.cpp \
 	../src/importexpressionmatrix.cpp \
+	../src/indexcorrelationmatrix_input.cpp \
+	../src/indexcorrelationmatrix.cpp \
+	../src/mergesimilarity_input.cpp \
+	../src/mergesimilarity.cpp \
 	../src/pairwise_clustering.cpp \
 	../src/pairwise_correlation.cpp \
 	../src/pairwise_gmm.cpp \
@@ -41,10 +48,12 @@ SOURCES += \
 	../src/pairwise_kmeans.cpp \
 	../src/pairwise_linalg.cpp \
 	../src/pairwise_matrix.cpp \
+	../src/pairwise_matrixwindow.cpp \
 	../src/pairwise_pearson.cpp \
 	../src/pairwise_spearman.cpp \
 	../src/rmt_input.cpp \
 	../src/rmt.cpp \
+	../src/similarity_checkpoint.cpp \
 	../src/similarity_input.cpp \
 	../src/similarity_opencl_fetchpair.cpp \
    ../src/similarity_opencl_gmm.cpp \
@@ -53,10 +62,15 @@ SOURCES += \
    ../src/similarity_opencl_spearman.cpp \
    ../src/similarity_opencl_worker.cpp \
    ../src/similarity_opencl.cpp \
+	../src/similarity_pairset.cpp \
 	../src/similarity_resultblock.cpp \
 	../src/similarity_serial.cpp \
+	../src/similarity_statistics.cpp \
 	../src/similarity_workblock.cpp \
 	../src/similarity.cpp \
+	../src/textio.cpp \
+	../src/transformexpressionmatrix_input.cpp \
+	../src/transformexpressionmatrix.cpp \
 	testclustermatrix.cpp \
 	testcorrelationmatrix.cpp \
 	testexportcorrelationmatrix.cpp \
@@ -64,13 +78,17 @@ SOURCES += \
 	testexpressionmatrix.cpp \
 	testimportcorrelationmatrix.cpp \
 	testimportexpressionmatrix.cpp \
+	testindex.cpp \
+	testpairset.cpp \
 	testrmt.cpp \
 	testsimilarity.cpp \
+	testtextio.cpp \
 	main.cpp
 
 HEADERS += \
 	../src/analyticfactory.h \
 	../src/ccmatrix.h \
+	../src/correlationmatrix_thresholdindex.h \
 	../src/correlationmatrix.h \
 	../src/datafactory.h \
 	../src/expressionmatrix.h \
@@ -80,10 +98,16 @@ HEADERS += \
 	../src/exportcorrelationmatrix.h \
 	../src/exportexpressionmatrix_input.h \
 	../src/exportexpressionmatrix.h \
+	../src/importbinaryexpressionmatrix_input.h \
+	../src/importbinaryexpressionmatrix.h \
 	../src/importcorrelationmatrix_input.h \
 	../src/importcorrelationmatrix.h \
 	../src/importexpressionmatrix_input.h \
 	../src/importexpressionmatrix.h \
+	../src/indexcorrelationmatrix_input.h \
+	../src/indexcorrelationmatrix.h \
+	../src/mergesimilarity_input.h \
+	../src/mergesimilarity.h \
 	../src/pairwise_clustering.h \
 	../src/pairwise_correlation.h \
 	../src/pairwise_gmm.h \
@@ -91,10 +115,12 @@ HEADERS += \
 	../src/pairwise_kmeans.h \
 	../src/pairwise_linalg.h \
 	../src/pairwise_matrix.h \
+	../src/pairwise_matrixwindow.h \
 	../src/pairwise_pearson.h \
 	../src/pairwise_spearman.h \
 	../src/rmt_input.h \
 	../src/rmt.h \
+	../src/similarity_checkpoint.h \
 	../src/similarity_input.h \
 	../src/similarity_opencl_fetchpair.h \
    ../src/similarity_opencl_gmm.h \
@@ -103,10 +129,15 @@ HEADERS += \
    ../src/similarity_opencl_spearman.h \
    ../src/similarity_opencl_worker.h \
    ../src/similarity_opencl.h \
+	../src/similarity_pairset.h \
 	../src/similarity_resultblock.h \
 	../src/similarity_serial.h \
+	../src/similarity_statistics.h \
 	../src/similarity_workblock.h \
 	../src/similarity.h \
+	../src/textio.h \
+	../src/transformexpressionmatrix_input.h \
+	../src/transformexpressionmatrix.h \
 	testclustermatrix.h \
 	testcorrelationmatrix.h \
 	testexportcorrelationmatrix.h \
@@ -114,5 +145,8 @@ HEADERS += \
 	testexpressionmatrix.h \
 	testimportcorrelationmatrix.h \
 	testimportexpressionmatrix.h \
+	testindex.h \
+	testpairset.h \
 	testrmt.h \
-	testsimilarity.h
+	testsimilarity.h \
+	testtextio.h
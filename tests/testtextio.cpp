@@ -0,0 +1,109 @@
+#include <ace/core/core.h>
+
+#include "testtextio.h"
+#include "textio.h"
+
+
+
+void TestTextIO::test()
+{
+	// verify that parsed floats match the general conversion for various formats
+	QStringList formats {"%.6g", "%.9g", "%.12g", "%.3f", "%.17g", "%e"};
+
+	for ( int i = 0; i < 10000; ++i )
+	{
+		double value = ldexp(-1.0 + 2.0 * rand() / RAND_MAX, rand() % 60 - 30);
+		QByteArray token {QString::asprintf(formats.at(i % formats.size()).toLatin1().constData(), value).toLatin1()};
+
+		float parsed;
+		QVERIFY(TextIO::parseFloat(token.constData(), token.constData() + token.size(), &parsed));
+		QCOMPARE(parsed, (float)token.toDouble());
+	}
+
+	// verify special values and invalid tokens
+	float parsed;
+	QByteArray nan {"nan"};
+	QVERIFY(TextIO::parseFloat(nan.constData(), nan.constData() + nan.size(), &parsed));
+	QVERIFY(std::isnan(parsed));
+
+	for ( QByteArray token : { "", "-", "1e", "NA", "12abc" } )
+	{
+		QVERIFY(!TextIO::parseFloat(token.constData(), token.constData() + token.size(), &parsed));
+	}
+
+	// verify that lines and tokens are split on newlines and whitespace
+	QByteArray line {"  gene1\t1.5 \r\nnext"};
+	const char* end {line.constData() + line.size()};
+	const char* lineEnd {TextIO::lineEnd(line.constData(), end)};
+	QCOMPARE(*lineEnd, '\n');
+
+	const char* p {TextIO::skipSpace(line.constData(), lineEnd)};
+	const char* tokenEnd {TextIO::skipToken(p, lineEnd)};
+	QCOMPARE(QByteArray(p, tokenEnd - p), QByteArray("gene1"));
+
+	p = TextIO::skipSpace(tokenEnd, lineEnd);
+	tokenEnd = TextIO::skipToken(p, lineEnd);
+	QCOMPARE(QByteArray(p, tokenEnd - p), QByteArray("1.5"));
+	QCOMPARE(TextIO::skipSpace(tokenEnd, lineEnd), lineEnd);
+
+	// verify integers and their range
+	qint32 integer;
+	QByteArray minimum {"-2147483648"};
+	QVERIFY(TextIO::parseInt(minimum.constData(), minimum.constData() + minimum.size(), &integer));
+	QCOMPARE(integer, std::numeric_limits<qint32>::min());
+
+	for ( QByteArray token : { "", "+", "2147483648", "1.0", "12a" } )
+	{
+		QVERIFY(!TextIO::parseInt(token.constData(), token.constData() + token.size(), &integer));
+	}
+
+	// verify that sample masks of every length are packed in the cluster matrix layout
+	for ( int size = 0; size < 40; ++size )
+	{
+		QByteArray mask;
+		for ( int i = 0; i < size; ++i )
+		{
+			mask.append('0' + rand() % 10);
+		}
+
+		QByteArray packed((size + 1) / 2, 0);
+		QVERIFY(TextIO::packMask(mask.constData(), mask.constData() + size, packed.data()));
+
+		for ( int i = 0; i < size; ++i )
+		{
+			QCOMPARE((packed[i / 2] >> (i % 2 * 4)) & 0x0F, mask[i] - '0');
+		}
+
+		if ( size > 0 )
+		{
+			mask[rand() % size] = ':';
+			QVERIFY(!TextIO::packMask(mask.constData(), mask.constData() + size, packed.data()));
+		}
+	}
+
+	// verify that formatted numbers match the general conversion
+	char text[64];
+
+	for ( int i = 0; i < 10000; ++i )
+	{
+		float value = ldexp(-1.0 + 2.0 * rand() / RAND_MAX, rand() % 60 - 30);
+		char* end = TextIO::formatFloat(text, value);
+
+		QCOMPARE(QByteArray(text, end - text), QByteArray::number(value, 'g', 6));
+	}
+
+	for ( qint64 value : { 0ll, 7ll, -42ll, 123456789012ll } )
+	{
+		char* end = TextIO::formatInt(text, value);
+
+		QCOMPARE(QByteArray(text, end - text), QByteArray::number(value));
+	}
+
+	// verify that packed sample masks are expanded back to the same digits
+	QByteArray mask {"0123456789987654321"};
+	QByteArray packed((mask.size() + 1) / 2, 0);
+	QVERIFY(TextIO::packMask(mask.constData(), mask.constData() + mask.size(), packed.data()));
+
+	char* end = TextIO::unpackMask(text, packed.constData(), mask.size());
+	QCOMPARE(QByteArray(text, end - text), mask);
+}
@@ -0,0 +1,16 @@
+#ifndef TESTTEXTIO_H
+#define TESTTEXTIO_H
+#include <QtTest/QtTest>
+
+
+
+class TestTextIO : public QObject
+{
+	Q_OBJECT
+private slots:
+	void test();
+};
+
+
+
+#endif